@@ -17,7 +17,6 @@
 */
 #include "components/alarm/AlarmController.h"
 #include "systemtask/SystemTask.h"
-#include "task.h"
 #include <chrono>
 
 using namespace Pinetime::Controllers;
@@ -26,16 +25,8 @@ using namespace std::chrono_literals;
 AlarmController::AlarmController(Controllers::DateTime& dateTimeController) : dateTimeController {dateTimeController} {
 }
 
-namespace {
-  void SetOffAlarm(TimerHandle_t xTimer) {
-    auto* controller = static_cast<Pinetime::Controllers::AlarmController*>(pvTimerGetTimerID(xTimer));
-    controller->SetOffAlarmNow();
-  }
-}
-
 void AlarmController::Init(System::SystemTask* systemTask) {
   this->systemTask = systemTask;
-  alarmTimer = xTimerCreate("Alarm", 1, pdFALSE, this, SetOffAlarm);
 }
 
 void AlarmController::SetAlarmTime(uint8_t alarmHr, uint8_t alarmMin) {
@@ -44,40 +35,30 @@ void AlarmController::SetAlarmTime(uint8_t alarmHr, uint8_t alarmMin) {
 }
 
 void AlarmController::ScheduleAlarm() {
-  // Determine the next time the alarm needs to go off and set the timer
-  xTimerStop(alarmTimer, 0);
+  // Determine the next time the alarm needs to go off. The time is kept in local time, so the
+  // alarm time is computed from the beginning of the current day.
+  using days = std::chrono::duration<int32_t, std::ratio<24 * 60 * 60>>;
 
   auto now = dateTimeController.CurrentDateTime();
-  alarmTime = now;
-  time_t ttAlarmTime = std::chrono::system_clock::to_time_t(std::chrono::time_point_cast<std::chrono::system_clock::duration>(alarmTime));
-  tm* tmAlarmTime = std::localtime(&ttAlarmTime);
+  alarmTime = std::chrono::time_point_cast<days>(now) + std::chrono::hours(hours) + std::chrono::minutes(minutes);
 
   // If the time being set has already passed today,the alarm should be set for tomorrow
-  if (hours < dateTimeController.Hours() || (hours == dateTimeController.Hours() && minutes <= dateTimeController.Minutes())) {
-    tmAlarmTime->tm_mday += 1;
-    // tm_wday doesn't update automatically
-    tmAlarmTime->tm_wday = (tmAlarmTime->tm_wday + 1) % 7;
+  if (alarmTime <= now) {
+    alarmTime += days(1);
   }
 
-  tmAlarmTime->tm_hour = hours;
-  tmAlarmTime->tm_min = minutes;
-  tmAlarmTime->tm_sec = 0;
-
   // if alarm is in weekday-only mode, make sure it shifts to the next weekday
   if (recurrence == RecurType::Weekdays) {
-    if (tmAlarmTime->tm_wday == 0) { // Sunday, shift 1 day
-      tmAlarmTime->tm_mday += 1;
-    } else if (tmAlarmTime->tm_wday == 6) { // Saturday, shift 2 days
-      tmAlarmTime->tm_mday += 2;
+    // 1970-01-01 was a Thursday
+    auto weekDay = (std::chrono::time_point_cast<days>(alarmTime).time_since_epoch().count() + 4) % 7;
+    if (weekDay == 0) { // Sunday, shift 1 day
+      alarmTime += days(1);
+    } else if (weekDay == 6) { // Saturday, shift 2 days
+      alarmTime += days(2);
     }
   }
-  tmAlarmTime->tm_isdst = -1; // use system timezone setting to determine DST
 
-  // now can convert back to a time_point
-  alarmTime = std::chrono::system_clock::from_time_t(std::mktime(tmAlarmTime));
-  auto secondsToAlarm = std::chrono::duration_cast<std::chrono::seconds>(alarmTime - now).count();
-  xTimerChangePeriod(alarmTimer, secondsToAlarm * configTICK_RATE_HZ, 0);
-  xTimerStart(alarmTimer, 0);
+  dateTimeController.SetAlarm(alarmTime);
 
   state = AlarmState::Set;
 }
@@ -87,13 +68,12 @@ uint32_t AlarmController::SecondsToAlarm() const {
 }
 
 void AlarmController::DisableAlarm() {
-  xTimerStop(alarmTimer, 0);
+  dateTimeController.CancelAlarm();
   state = AlarmState::Not_Set;
 }
 
 void AlarmController::SetOffAlarmNow() {
   state = AlarmState::Alerting;
-  systemTask->PushMessage(System::Messages::SetOffAlarm);
 }
 
 void AlarmController::StopAlerting() {
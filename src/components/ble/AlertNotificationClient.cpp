@@ -1,5 +1,6 @@
 #include "components/ble/AlertNotificationClient.h"
 #include <algorithm>
+#include "components/ble/MbufReader.h"
 #include "components/ble/NotificationManager.h"
 #include "systemtask/SystemTask.h"
 #include <nrf_log.h>
@@ -143,23 +144,21 @@ int AlertNotificationClient::OnDescriptorDiscoveryEventCallback(uint16_t connect
 
 void AlertNotificationClient::OnNotification(ble_gap_event* event) {
   if (event->notify_rx.attr_handle == newAlertHandle) {
-    constexpr size_t stringTerminatorSize = 1; // end of string '\0'
     constexpr size_t headerSize = 3;
     const auto maxMessageSize {NotificationManager::MaximumMessageSize()};
-    const auto maxBufferSize {maxMessageSize + headerSize};
 
     // Ignore notifications with empty message
     const auto packetLen = OS_MBUF_PKTLEN(event->notify_rx.om);
     if (packetLen <= headerSize)
       return;
 
-    size_t bufferSize = std::min(packetLen + stringTerminatorSize, maxBufferSize);
-    auto messageSize = std::min(maxMessageSize, (bufferSize - headerSize));
+    MbufReader reader {event->notify_rx.om};
+    reader.Skip(headerSize);
 
     NotificationManager::Notification notif;
-    os_mbuf_copydata(event->notify_rx.om, headerSize, messageSize - 1, notif.message.data());
-    notif.message[messageSize - 1] = '\0';
-    notif.size = messageSize;
+    size_t messageSize = reader.ReadUpTo(notif.message.data(), maxMessageSize - 1);
+    notif.message[messageSize] = '\0';
+    notif.size = messageSize + 1;
     notif.category = Pinetime::Controllers::NotificationManager::Categories::SimpleAlert;
     notificationManager.Push(std::move(notif));
 
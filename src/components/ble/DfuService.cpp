@@ -12,6 +12,34 @@ constexpr ble_uuid128_t DfuService::controlPointCharacteristicUuid;
 constexpr ble_uuid128_t DfuService::revisionCharacteristicUuid;
 constexpr ble_uuid128_t DfuService::packetCharacteristicUuid;
 
+namespace {
+  // CRC-16/CCITT (polynomial 0x1021) of each value of the upper byte of the CRC register
+  constexpr std::array<uint16_t, 256> MakeCrcTable() {
+    std::array<uint16_t, 256> table {};
+    for (uint16_t i = 0; i < table.size(); i++) {
+      uint16_t crc = i << 8;
+      for (int bit = 0; bit < 8; bit++) {
+        crc = (crc & 0x8000u) ? (crc << 1) ^ 0x1021u : crc << 1;
+      }
+      table[i] = crc;
+    }
+    return table;
+  }
+
+  constexpr std::array<uint16_t, 256> crcTable = MakeCrcTable();
+
+  constexpr uint16_t ComputeCrc(const uint8_t* data, size_t size, uint16_t crc) {
+    for (size_t i = 0; i < size; i++) {
+      crc = static_cast<uint16_t>((crc << 8) ^ crcTable[(crc >> 8) ^ data[i]]);
+    }
+    return crc;
+  }
+
+  // Check value of CRC-16/CCITT-FALSE (initial value 0xffff)
+  constexpr uint8_t crcCheckData[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  static_assert(ComputeCrc(crcCheckData, sizeof(crcCheckData), 0xffff) == 0x29b1, "Invalid CRC table");
+}
+
 int DfuServiceCallback(uint16_t conn_handle, uint16_t attr_handle, struct ble_gatt_access_ctxt* ctxt, void* arg) {
   auto dfuService = static_cast<DfuService*>(arg);
   return dfuService->OnServiceData(conn_handle, attr_handle, ctxt);
@@ -160,9 +188,12 @@ int DfuService::WritePacketHandler(uint16_t connectionHandle, os_mbuf* om) {
     }
 
     case States::Data: {
+      // Packets can be as large as the negotiated MTU allows, and span several chained mbufs
       nbPacketReceived++;
-      dfuImage.Append(om->om_data, om->om_len);
-      bytesReceived += om->om_len;
+      for (os_mbuf* buffer = om; buffer != nullptr; buffer = SLIST_NEXT(buffer, om_next)) {
+        dfuImage.Append(buffer->om_data, buffer->om_len);
+      }
+      bytesReceived += OS_MBUF_PKTLEN(om);
       bleController.FirmwareUpdateCurrentBytes(bytesReceived);
 
       if ((nbPacketReceived % nbPacketsToNotify) == 0 && bytesReceived != applicationSize) {
@@ -246,8 +277,7 @@ int DfuService::ControlPointHandler(uint16_t connectionHandle, os_mbuf* om) {
         NRF_LOG_INFO("[DFU] -> Receive firmware image requested, but we are not in Start Init");
         return 0;
       }
-      // TODO the chunk size is dependent of the implementation of the host application...
-      dfuImage.Init(20, applicationSize, expectedCrc);
+      dfuImage.Init(applicationSize, expectedCrc);
       NRF_LOG_INFO("[DFU] -> Starting receive firmware");
       state = States::Data;
       return 0;
@@ -350,37 +380,87 @@ void DfuService::NotificationManager::Reset() {
   xTimerStop(timer, 0);
 }
 
-void DfuService::DfuImage::Init(size_t chunkSize, size_t totalSize, uint16_t expectedCrc) {
-  if (chunkSize != 20)
-    return;
-  this->chunkSize = chunkSize;
+void DfuService::DfuImage::Init(size_t totalSize, uint16_t expectedCrc) {
+  if (writerTaskHandle == nullptr) {
+    pendingBuffers = xQueueCreate(nbBuffers, sizeof(uint8_t));
+    freeBuffers = xQueueCreate(nbBuffers, sizeof(uint8_t));
+    for (uint8_t i = 0; i < nbBuffers; i++) {
+      if (i != currentBuffer) {
+        xQueueSend(freeBuffers, &i, 0);
+      }
+    }
+    if (pdPASS != xTaskCreate(DfuImage::Process, "dfuwriter", 200, this, 1, &writerTaskHandle)) {
+      APP_ERROR_HANDLER(NRF_ERROR_NO_MEM);
+    }
+  } else {
+    WaitWritesCompleted();
+  }
+
   this->totalSize = totalSize;
   this->expectedCrc = expectedCrc;
+  this->bufferWriteIndex = 0;
+  this->totalWriteIndex = 0;
+  this->crc = 0xFFFF;
+  this->writeFailed = false;
   this->ready = true;
 }
 
-void DfuService::DfuImage::Append(uint8_t* data, size_t size) {
+void DfuService::DfuImage::Append(const uint8_t* data, size_t size) {
   if (!ready)
     return;
-  ASSERT(size <= 20);
-
-  std::memcpy(tempBuffer + bufferWriteIndex, data, size);
-  bufferWriteIndex += size;
 
-  if (bufferWriteIndex == bufferSize) {
-    spiNorFlash.Write(writeOffset + totalWriteIndex, tempBuffer, bufferWriteIndex);
-    totalWriteIndex += bufferWriteIndex;
-    bufferWriteIndex = 0;
+  while (size > 0 && totalWriteIndex < totalSize) {
+    size_t toCopy = (bufferSize - bufferWriteIndex) > size ? size : (bufferSize - bufferWriteIndex);
+    std::memcpy(buffers[currentBuffer].data + bufferWriteIndex, data, toCopy);
+    crc = ComputeCrc(data, toCopy, crc);
+    bufferWriteIndex += toCopy;
+    data += toCopy;
+    size -= toCopy;
+
+    if (bufferWriteIndex == bufferSize || totalWriteIndex + bufferWriteIndex == totalSize) {
+      QueueBuffer(writeOffset + totalWriteIndex, bufferWriteIndex);
+      totalWriteIndex += bufferWriteIndex;
+      bufferWriteIndex = 0;
+
+      if (totalWriteIndex == totalSize && totalSize < maxSize)
+        WriteMagicNumber();
+    }
   }
+}
+
+void DfuService::DfuImage::QueueBuffer(uint32_t address, size_t size) {
+  buffers[currentBuffer].address = address;
+  buffers[currentBuffer].size = size;
+  xQueueSend(pendingBuffers, &currentBuffer, portMAX_DELAY);
+  // Blocks the BLE host until a buffer is programmed if the flash memory can't keep up
+  xQueueReceive(freeBuffers, &currentBuffer, portMAX_DELAY);
+}
+
+void DfuService::DfuImage::Process(void* instance) {
+  auto* dfuImage = static_cast<DfuImage*>(instance);
+  dfuImage->WriteBuffers();
+}
 
-  if (bufferWriteIndex > 0 && totalWriteIndex + bufferWriteIndex == totalSize) {
-    spiNorFlash.Write(writeOffset + totalWriteIndex, tempBuffer, bufferWriteIndex);
-    totalWriteIndex += bufferWriteIndex;
-    if (totalSize < maxSize)
-      WriteMagicNumber();
+void DfuService::DfuImage::WriteBuffers() {
+  uint8_t index;
+  while (true) {
+    if (xQueueReceive(pendingBuffers, &index, portMAX_DELAY) == pdTRUE) {
+      spiNorFlash.Write(buffers[index].address, buffers[index].data, buffers[index].size);
+      if (spiNorFlash.ProgramFailed()) {
+        writeFailed = true;
+      }
+      xQueueSend(freeBuffers, &index, portMAX_DELAY);
+    }
   }
 }
 
+void DfuService::DfuImage::WaitWritesCompleted() {
+  if (writerTaskHandle == nullptr)
+    return;
+  while (uxQueueMessagesWaiting(freeBuffers) < nbBuffers - 1u)
+    vTaskDelay(1);
+}
+
 void DfuService::DfuImage::WriteMagicNumber() {
   uint32_t magic[4] = {
     // TODO When this variable is a static constexpr, the values written to the memory are not correct. Why?
@@ -390,49 +470,19 @@ void DfuService::DfuImage::WriteMagicNumber() {
     0x8079b62c,
   };
 
-  uint32_t offset = writeOffset + (maxSize - (4 * sizeof(uint32_t)));
-  spiNorFlash.Write(offset, reinterpret_cast<const uint8_t*>(magic), 4 * sizeof(uint32_t));
+  std::memcpy(buffers[currentBuffer].data, magic, sizeof(magic));
+  QueueBuffer(writeOffset + (maxSize - sizeof(magic)), sizeof(magic));
 }
 
 void DfuService::DfuImage::Erase() {
-  for (size_t erased = 0; erased < maxSize; erased += 0x1000) {
-    spiNorFlash.SectorErase(writeOffset + erased);
-  }
+  WaitWritesCompleted();
+  spiNorFlash.Erase(writeOffset, maxSize);
 }
 
+// The CRC is computed as the data is received, so there's no need to read the image back
 bool DfuService::DfuImage::Validate() {
-  uint32_t chunkSize = 200;
-  size_t currentOffset = 0;
-  uint16_t crc = 0;
-
-  bool first = true;
-  while (currentOffset < totalSize) {
-    uint32_t readSize = (totalSize - currentOffset) > chunkSize ? chunkSize : (totalSize - currentOffset);
-
-    spiNorFlash.Read(writeOffset + currentOffset, tempBuffer, readSize);
-    if (first) {
-      crc = ComputeCrc(tempBuffer, readSize, NULL);
-      first = false;
-    } else
-      crc = ComputeCrc(tempBuffer, readSize, &crc);
-    currentOffset += readSize;
-  }
-
-  return (crc == expectedCrc);
-}
-
-uint16_t DfuService::DfuImage::ComputeCrc(uint8_t const* p_data, uint32_t size, uint16_t const* p_crc) {
-  uint16_t crc = (p_crc == NULL) ? 0xFFFF : *p_crc;
-
-  for (uint32_t i = 0; i < size; i++) {
-    crc = static_cast<uint8_t>(crc >> 8) | (crc << 8);
-    crc ^= p_data[i];
-    crc ^= static_cast<uint8_t>(crc & 0xFF) >> 4;
-    crc ^= (crc << 8) << 4;
-    crc ^= ((crc & 0xFF) << 4) << 1;
-  }
-
-  return crc;
+  WaitWritesCompleted();
+  return !writeFailed && crc == expectedCrc;
 }
 
 bool DfuService::DfuImage::IsComplete() {
@@ -2,6 +2,9 @@
 
 #include <cstdint>
 #include <array>
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <task.h>
 
 #define min // workaround: nimble's min/max macros conflict with libstdc++
 #define max
@@ -54,27 +57,46 @@ namespace Pinetime {
         DfuImage(Pinetime::Drivers::SpiNorFlash& spiNorFlash) : spiNorFlash {spiNorFlash} {
         }
 
-        void Init(size_t chunkSize, size_t totalSize, uint16_t expectedCrc);
+        void Init(size_t totalSize, uint16_t expectedCrc);
         void Erase();
-        void Append(uint8_t* data, size_t size);
+        void Append(const uint8_t* data, size_t size);
         bool Validate();
         bool IsComplete();
 
       private:
+        // Received data is copied into page sized buffers, which are programmed by a dedicated task
+        // so that the BLE host can process the next packets in the meantime.
+        struct Buffer {
+          uint32_t address;
+          size_t size;
+          uint8_t data[256];
+        };
+        static constexpr size_t bufferSize = sizeof(Buffer::data);
+        static constexpr uint8_t nbBuffers = 4;
+
         Pinetime::Drivers::SpiNorFlash& spiNorFlash;
-        static constexpr size_t bufferSize = 200;
         bool ready = false;
-        size_t chunkSize = 0;
         size_t totalSize = 0;
         size_t maxSize = 475136;
         size_t bufferWriteIndex = 0;
         size_t totalWriteIndex = 0;
         static constexpr size_t writeOffset = 0x40000;
-        uint8_t tempBuffer[bufferSize];
+        std::array<Buffer, nbBuffers> buffers;
+        // Buffer being filled, owned by the BLE host task. The other ones are either pending or free.
+        uint8_t currentBuffer = 0;
+        QueueHandle_t pendingBuffers = nullptr;
+        QueueHandle_t freeBuffers = nullptr;
+        TaskHandle_t writerTaskHandle = nullptr;
         uint16_t expectedCrc = 0;
-
+        // CRC of the data received so far
+        uint16_t crc = 0xFFFF;
+        bool writeFailed = false;
+
+        static void Process(void* instance);
+        void WriteBuffers();
+        void QueueBuffer(uint32_t address, size_t size);
+        void WaitWritesCompleted();
         void WriteMagicNumber();
-        uint16_t ComputeCrc(uint8_t const* p_data, uint32_t size, uint16_t const* p_crc);
       };
 
     private:
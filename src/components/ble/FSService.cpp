@@ -71,7 +71,6 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
   }
   lfs_dir_t dir = {0};
   lfs_info info = {0};
-  lfs_file f = {0};
   switch (command) {
     case commands::READ: {
       NRF_LOG_INFO("[FS_S] -> Read");
@@ -80,64 +79,26 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
       if (plen > maxpathlen) { //> counts for null term
         return -1;
       }
+      CloseFile();
       memcpy(filepath, header->pathstr, plen);
       filepath[plen] = 0; // Copy and null terminate string
-      ReadResponse resp;
-      os_mbuf* om;
-      resp.command = commands::READ_DATA;
-      resp.status = 0x01;
-      resp.chunkoff = header->chunkoff;
-      int res = fs.Stat(filepath, &info);
-      if (res == LFS_ERR_NOENT && info.type != LFS_TYPE_DIR) {
+      int res = OpenFile(FSState::READ, LFS_O_RDONLY);
+      if (res < 0) {
+        ReadResponse resp {};
+        resp.command = commands::READ_DATA;
         resp.status = (int8_t) res;
-        resp.chunklen = 0;
-        resp.totallen = 0;
-        om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
-      } else {
-        resp.chunklen = std::min(header->chunksize, info.size); // TODO add mtu somehow
-        resp.totallen = info.size;
-        fs.FileOpen(&f, filepath, LFS_O_RDONLY);
-        fs.FileSeek(&f, header->chunkoff);
-        uint8_t fileData[resp.chunklen] = {0};
-        resp.chunklen = fs.FileRead(&f, fileData, resp.chunklen);
-        om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
-        os_mbuf_append(om, fileData, resp.chunklen);
-        fs.FileClose(&f);
+        resp.chunkoff = header->chunkoff;
+        auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
+        ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+        break;
       }
-
-      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+      SendReadData(connectionHandle, header->chunkoff, header->chunksize);
       break;
     }
     case commands::READ_PACING: {
       NRF_LOG_INFO("[FS_S] -> Readpacing");
-      auto* header = (ReadHeader*) om->om_data;
-      ReadResponse resp;
-      resp.command = commands::READ_DATA;
-      resp.status = 0x01;
-      resp.chunkoff = header->chunkoff;
-      int res = fs.Stat(filepath, &info);
-      if (res == LFS_ERR_NOENT && info.type != LFS_TYPE_DIR) {
-        resp.status = (int8_t) res;
-        resp.chunklen = 0;
-        resp.totallen = 0;
-      } else {
-        resp.chunklen = std::min(header->chunksize, info.size); // TODO add mtu somehow
-        resp.totallen = info.size;
-        fs.FileOpen(&f, filepath, LFS_O_RDONLY);
-        fs.FileSeek(&f, header->chunkoff);
-      }
-      os_mbuf* om;
-      if (resp.chunklen > 0) {
-        uint8_t fileData[resp.chunklen] = {0};
-        resp.chunklen = fs.FileRead(&f, fileData, resp.chunklen);
-        om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
-        os_mbuf_append(om, fileData, resp.chunklen);
-      } else {
-        resp.chunklen = 0;
-        om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
-      }
-      fs.FileClose(&f);
-      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+      auto* header = (ReadPacing*) om->om_data;
+      SendReadData(connectionHandle, header->chunkoff, header->chunksize);
       break;
     }
     case commands::WRITE: {
@@ -147,6 +108,7 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
       if (plen > maxpathlen) { //> counts for null term
         return -1;             // TODO make this actually return a BLE notif
       }
+      CloseFile();
       memcpy(filepath, header->pathstr, plen);
       filepath[plen] = 0; // Copy and null terminate string
       fileSize = header->totalSize;
@@ -155,11 +117,8 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
       resp.offset = header->offset;
       resp.modTime = 0;
 
-      int res = fs.FileOpen(&f, filepath, LFS_O_RDWR | LFS_O_CREAT);
-      if (res == 0) {
-        fs.FileClose(&f);
-        resp.status = (res == 0) ? 0x01 : (int8_t) res;
-      }
+      int res = OpenFile(FSState::WRITE, LFS_O_RDWR | LFS_O_CREAT);
+      resp.status = (res == 0) ? 0x01 : (int8_t) res;
       resp.freespace = std::min(fs.getSize() - (fs.GetFSSize() * fs.getBlockSize()), fileSize - header->offset);
       auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(WriteResponse));
       ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
@@ -171,16 +130,29 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
       WriteResponse resp;
       resp.command = commands::WRITE_PACING;
       resp.offset = header->offset;
+      resp.status = 0x01;
       int res = 0;
 
-      if (!(res = fs.FileOpen(&f, filepath, LFS_O_RDWR | LFS_O_CREAT))) {
-        if ((res = fs.FileSeek(&f, header->offset)) >= 0) {
-          res = fs.FileWrite(&f, header->data, header->dataSize);
-        }
-        fs.FileClose(&f);
+      if (state == FSState::READ) {
+        // The file opened for reading is not the one announced by the WRITE command
+        resp.status = (int8_t) LFS_ERR_BADF;
+        resp.freespace = 0;
+        auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(WriteResponse));
+        ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+        break;
+      }
+      if (state == FSState::IDLE) {
+        res = OpenFile(FSState::WRITE, LFS_O_RDWR | LFS_O_CREAT);
+      }
+      if (res == 0 && (res = fs.FileSeek(&file, header->offset)) >= 0) {
+        res = fs.FileWrite(&file, header->data, header->dataSize);
       }
       if (res < 0) {
         resp.status = (int8_t) res;
+        CloseFile();
+      } else if (header->offset + header->dataSize >= static_cast<uint32_t>(fileSize)) {
+        // Last chunk, commit the file
+        CloseFile();
       }
       resp.freespace = std::min(fs.getSize() - (fs.GetFSSize() * fs.getBlockSize()), fileSize - header->offset);
       auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(WriteResponse));
@@ -189,6 +161,7 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
     }
     case commands::DELETE: {
       NRF_LOG_INFO("[FS_S] -> Delete");
+      CloseFile();
       auto* header = (DelHeader*) om->om_data;
       uint16_t plen = header->pathlen;
       char path[plen + 1] = {0};
@@ -204,6 +177,7 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
     }
     case commands::MKDIR: {
       NRF_LOG_INFO("[FS_S] -> MKDir");
+      CloseFile();
       auto* header = (MKDirHeader*) om->om_data;
       uint16_t plen = header->pathlen;
       char path[plen + 1] = {0};
@@ -220,6 +194,7 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
     }
     case commands::LISTDIR: {
       NRF_LOG_INFO("[FS_S] -> ListDir");
+      CloseFile();
       ListDirHeader* header = (ListDirHeader*) om->om_data;
       uint16_t plen = header->pathlen;
       char path[plen + 1] = {0};
@@ -284,6 +259,7 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
     }
     case commands::MOVE: {
       NRF_LOG_INFO("[FS_S] -> Move");
+      CloseFile();
       MoveHeader* header = (MoveHeader*) om->om_data;
       uint16_t plen = header->OldPathLength;
       // Null Terminate string
@@ -306,25 +282,59 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
   return 0;
 }
 
-// Loads resp with file data given a valid filepath header and resp
-void FSService::prepareReadDataResp(ReadHeader* header, ReadResponse* resp) {
-  // uint16_t plen = header->pathlen;
-  resp->command = commands::READ_DATA;
-  resp->chunkoff = header->chunkoff;
-  resp->status = 0x01;
-  struct lfs_info info = {};
-  int res = fs.Stat(filepath, &info);
-  if (res == LFS_ERR_NOENT && info.type != LFS_TYPE_DIR) {
-    resp->status = 0x03;
-    resp->chunklen = 0;
-    resp->totallen = 0;
+void FSService::Reset() {
+  CloseFile();
+}
+
+int FSService::OpenFile(FSState newState, int flags) {
+  int res = fs.FileOpen(&file, filepath, flags);
+  state = (res == 0) ? newState : FSState::IDLE;
+  return res;
+}
+
+void FSService::CloseFile() {
+  if (state != FSState::IDLE) {
+    fs.FileClose(&file);
+    state = FSState::IDLE;
+  }
+}
+
+// Sends the chunk of the file being read at chunkOffset, as large as the client and the MTU allow
+void FSService::SendReadData(uint16_t connectionHandle, uint32_t chunkOffset, uint32_t chunkSize) {
+  ReadResponse resp {};
+  resp.command = commands::READ_DATA;
+  resp.status = 0x01;
+  resp.chunkoff = chunkOffset;
+
+  if (state != FSState::READ) {
+    resp.status = (int8_t) LFS_ERR_BADF;
+    auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
+    ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+    return;
+  }
+
+  uint16_t mtu = ble_att_mtu(connectionHandle);
+  size_t maxSize = mtu > 3 + sizeof(ReadResponse) ? mtu - 3 - sizeof(ReadResponse) : 0;
+  maxSize = std::min(maxSize, maxChunkSize);
+  resp.totallen = fs.FileSize(&file);
+  resp.chunklen = std::min(chunkSize, static_cast<uint32_t>(maxSize));
+
+  int res = fs.FileSeek(&file, chunkOffset);
+  if (res >= 0) {
+    res = fs.FileRead(&file, chunkBuffer, resp.chunklen);
+  }
+  if (res < 0) {
+    resp.status = (int8_t) res;
+    resp.chunklen = 0;
   } else {
-    lfs_file f;
-    resp->chunklen = std::min(header->chunksize, info.size);
-    resp->totallen = info.size;
-    fs.FileOpen(&f, filepath, LFS_O_RDONLY);
-    fs.FileSeek(&f, header->chunkoff);
-    resp->chunklen = fs.FileRead(&f, resp->chunk, resp->chunklen);
-    fs.FileClose(&f);
+    resp.chunklen = res;
+  }
+
+  auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
+  os_mbuf_append(om, chunkBuffer, resp.chunklen);
+  ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+
+  if (res < 0 || chunkOffset + resp.chunklen >= resp.totallen) {
+    CloseFile();
   }
 }
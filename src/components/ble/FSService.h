@@ -22,6 +22,7 @@ namespace Pinetime {
 
       int OnFSServiceRequested(uint16_t connectionHandle, uint16_t attributeHandle, ble_gatt_access_ctxt* context);
       void NotifyFSRaw(uint16_t connectionHandle);
+      void Reset();
 
     private:
       Pinetime::System::SystemTask& systemTask;
@@ -70,9 +71,11 @@ namespace Pinetime {
         READ = 0x01,
         WRITE = 0x02,
       };
-      FSState state;
+      FSState state = FSState::IDLE;
       char filepath[maxpathlen]; // TODO ..ugh fixed filepath len
       int fileSize;
+      // File being read or written, kept open for the whole transfer
+      lfs_file_t file;
 
       using ReadHeader = struct __attribute__((packed)) {
         commands command;
@@ -190,8 +193,15 @@ namespace Pinetime {
         uint8_t status;
       };
 
+      static constexpr uint16_t maxMtu = MYNEWT_VAL(BLE_ATT_PREFERRED_MTU);
+      // Notifications carry at most MTU - 3 bytes
+      static constexpr size_t maxChunkSize = maxMtu - 3 - sizeof(ReadResponse);
+      uint8_t chunkBuffer[maxChunkSize];
+
       int FSCommandHandler(uint16_t connectionHandle, os_mbuf* om);
-      void prepareReadDataResp(ReadHeader* header, ReadResponse* resp);
+      int OpenFile(FSState newState, int flags);
+      void CloseFile();
+      void SendReadData(uint16_t connectionHandle, uint32_t chunkOffset, uint32_t chunkSize);
     };
   }
 }
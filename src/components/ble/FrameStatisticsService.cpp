@@ -0,0 +1,71 @@
+#include "components/ble/FrameStatisticsService.h"
+#include "components/display/FrameStatistics.h"
+
+using namespace Pinetime::Controllers;
+
+namespace {
+  // 0006yyxx-78fc-48fe-8e23-433b3a1942d0
+  constexpr ble_uuid128_t CharUuid(uint8_t x, uint8_t y) {
+    return ble_uuid128_t {.u = {.type = BLE_UUID_TYPE_128},
+                          .value = {0xd0, 0x42, 0x19, 0x3a, 0x3b, 0x43, 0x23, 0x8e, 0xfe, 0x48, 0xfc, 0x78, x, y, 0x06, 0x00}};
+  }
+
+  // 00060000-78fc-48fe-8e23-433b3a1942d0
+  constexpr ble_uuid128_t BaseUuid() {
+    return CharUuid(0x00, 0x00);
+  }
+
+  constexpr ble_uuid128_t frameStatisticsServiceUuid {BaseUuid()};
+  constexpr ble_uuid128_t statisticsCharUuid {CharUuid(0x01, 0x00)};
+
+  int FrameStatisticsServiceCallback(uint16_t /*conn_handle*/, uint16_t attr_handle, struct ble_gatt_access_ctxt* ctxt, void* arg) {
+    auto* frameStatisticsService = static_cast<FrameStatisticsService*>(arg);
+    return frameStatisticsService->OnStatisticsRequested(attr_handle, ctxt);
+  }
+}
+
+FrameStatisticsService::FrameStatisticsService(Controllers::FrameStatistics& frameStatistics)
+  : frameStatistics {frameStatistics},
+    characteristicDefinition {{.uuid = &statisticsCharUuid.u,
+                               .access_cb = FrameStatisticsServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_READ,
+                               .val_handle = &statisticsHandle},
+                              {0}},
+    serviceDefinition {
+      {.type = BLE_GATT_SVC_TYPE_PRIMARY, .uuid = &frameStatisticsServiceUuid.u, .characteristics = characteristicDefinition},
+      {0},
+    } {
+}
+
+void FrameStatisticsService::Init() {
+  int res = 0;
+  res = ble_gatts_count_cfg(serviceDefinition);
+  ASSERT(res == 0);
+
+  res = ble_gatts_add_svcs(serviceDefinition);
+  ASSERT(res == 0);
+}
+
+int FrameStatisticsService::OnStatisticsRequested(uint16_t attributeHandle, ble_gatt_access_ctxt* context) {
+  if (attributeHandle == statisticsHandle) {
+    static constexpr size_t nbSummaries = 5;
+    const FrameStatistics::Summary summaries[nbSummaries] = {frameStatistics.RenderTime(),
+                                                             frameStatistics.FlushTime(),
+                                                             frameStatistics.BytesSent(),
+                                                             frameStatistics.NbAreas(),
+                                                             frameStatistics.NbTransactions()};
+    // Number of frames, then min/avg/max for each summary
+    uint32_t buffer[1 + (3 * nbSummaries)];
+    buffer[0] = frameStatistics.NbFrames();
+    for (size_t i = 0; i < nbSummaries; i++) {
+      buffer[1 + (i * 3)] = summaries[i].min;
+      buffer[2 + (i * 3)] = summaries[i].avg;
+      buffer[3 + (i * 3)] = summaries[i].max;
+    }
+
+    int res = os_mbuf_append(context->om, buffer, sizeof(buffer));
+    return (res == 0) ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+  }
+  return 0;
+}
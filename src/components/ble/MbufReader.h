@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#define min // workaround: nimble's min/max macros conflict with libstdc++
+#define max
+#include <os/os_mbuf.h>
+#undef max
+#undef min
+
+namespace Pinetime {
+  namespace Controllers {
+    // Reads the data of a packet sequentially, following the chain of mbufs.
+    // Reading past the end of the packet yields zeros and clears Ok(), so that a message can be parsed
+    // entirely before checking that it was long enough.
+    class MbufReader {
+    public:
+      explicit MbufReader(const os_mbuf* om) : current {om}, remaining {OS_MBUF_PKTLEN(om)} {
+      }
+
+      size_t Remaining() const {
+        return remaining;
+      }
+
+      bool Ok() const {
+        return ok;
+      }
+
+      // Copies size bytes into destination
+      void Read(void* destination, size_t size) {
+        auto* data = static_cast<uint8_t*>(destination);
+        size_t copied = Copy(data, size);
+        if (copied < size) {
+          std::memset(data + copied, 0, size - copied);
+          ok = false;
+        }
+      }
+
+      // Copies at most maxSize bytes into destination and returns the number of bytes copied
+      size_t ReadUpTo(void* destination, size_t maxSize) {
+        return Copy(static_cast<uint8_t*>(destination), maxSize);
+      }
+
+      // Copies the remaining data into value, up to the first '\0'
+      void ReadString(std::string& value) {
+        value.resize(remaining);
+        Read(value.data(), value.size());
+        value.resize(std::strlen(value.c_str()));
+      }
+
+      void Skip(size_t size) {
+        if (Copy(nullptr, size) < size) {
+          ok = false;
+        }
+      }
+
+      uint8_t ReadUint8() {
+        uint8_t value;
+        Read(&value, sizeof(value));
+        return value;
+      }
+
+      // Little endian
+      uint16_t ReadUint16() {
+        uint8_t data[2];
+        Read(data, sizeof(data));
+        return data[0] | (data[1] << 8);
+      }
+
+      // Big endian
+      uint32_t ReadUint32BigEndian() {
+        uint8_t data[4];
+        Read(data, sizeof(data));
+        return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+               (static_cast<uint32_t>(data[2]) << 8) | data[3];
+      }
+
+      // Little endian
+      uint64_t ReadUint64() {
+        uint8_t data[8];
+        Read(data, sizeof(data));
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; i--) {
+          value = (value << 8) | data[i];
+        }
+        return value;
+      }
+
+    private:
+      const os_mbuf* current;
+      size_t offset = 0;
+      size_t remaining;
+      bool ok = true;
+
+      // Copies (or skips if destination is null) up to size bytes, segment by segment
+      size_t Copy(uint8_t* destination, size_t size) {
+        size_t copied = 0;
+        while (copied < size && current != nullptr) {
+          size_t available = current->om_len - offset;
+          if (available == 0) {
+            current = SLIST_NEXT(current, om_next);
+            offset = 0;
+            continue;
+          }
+          size_t toCopy = available < size - copied ? available : size - copied;
+          if (destination != nullptr) {
+            std::memcpy(destination + copied, current->om_data + offset, toCopy);
+          }
+          offset += toCopy;
+          copied += toCopy;
+        }
+        remaining -= copied;
+        return copied;
+      }
+    };
+  }
+}
@@ -16,6 +16,7 @@
     along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 #include "components/ble/MusicService.h"
+#include "components/ble/MbufReader.h"
 #include "components/ble/NimbleController.h"
 #include <cstring>
 
@@ -123,32 +124,22 @@ void Pinetime::Controllers::MusicService::Init() {
 }
 
 int Pinetime::Controllers::MusicService::OnCommand(struct ble_gatt_access_ctxt* ctxt) {
-  if (ctxt->op == BLE_GATT_ACCESS_OP_WRITE_CHR) {
-    size_t notifSize = OS_MBUF_PKTLEN(ctxt->om);
-    size_t bufferSize = notifSize;
-    if (notifSize > MaxStringSize) {
-      bufferSize = MaxStringSize;
-    }
+  if (ctxt->op != BLE_GATT_ACCESS_OP_WRITE_CHR) {
+    return 0;
+  }
 
-    char data[bufferSize + 1];
-    os_mbuf_copydata(ctxt->om, 0, bufferSize, data);
+  MbufReader reader {ctxt->om};
+  const ble_uuid_t* uuid = ctxt->chr->uuid;
 
-    if (notifSize > bufferSize) {
-      data[bufferSize - 1] = '.';
-      data[bufferSize - 2] = '.';
-      data[bufferSize - 3] = '.';
+  // Flags (1 byte) and numbers (4 bytes, big endian). Packets that are too short are ignored.
+  if (ble_uuid_cmp(uuid, &msStatusCharUuid.u) == 0 || ble_uuid_cmp(uuid, &msRepeatCharUuid.u) == 0 ||
+      ble_uuid_cmp(uuid, &msShuffleCharUuid.u) == 0) {
+    uint8_t value = reader.ReadUint8();
+    if (!reader.Ok()) {
+      return 0;
     }
-    data[bufferSize] = '\0';
-
-    char* s = &data[0];
-    if (ble_uuid_cmp(ctxt->chr->uuid, &msArtistCharUuid.u) == 0) {
-      artistName = s;
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msTrackCharUuid.u) == 0) {
-      trackName = s;
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msAlbumCharUuid.u) == 0) {
-      albumName = s;
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msStatusCharUuid.u) == 0) {
-      playing = s[0];
+    if (ble_uuid_cmp(uuid, &msStatusCharUuid.u) == 0) {
+      playing = value;
       // These variables need to be updated, because the progress may not be updated immediately,
       // leading to getProgress() returning an incorrect position.
       if (playing) {
@@ -157,22 +148,54 @@ int Pinetime::Controllers::MusicService::OnCommand(struct ble_gatt_access_ctxt*
         trackProgress +=
           static_cast<int>((static_cast<float>(xTaskGetTickCount() - trackProgressUpdateTime) / 1024.0f) * getPlaybackSpeed());
       }
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msRepeatCharUuid.u) == 0) {
-      repeat = s[0];
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msShuffleCharUuid.u) == 0) {
-      shuffle = s[0];
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msPositionCharUuid.u) == 0) {
-      trackProgress = (s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
+    } else if (ble_uuid_cmp(uuid, &msRepeatCharUuid.u) == 0) {
+      repeat = value;
+    } else {
+      shuffle = value;
+    }
+    return 0;
+  }
+
+  if (ble_uuid_cmp(uuid, &msPositionCharUuid.u) == 0 || ble_uuid_cmp(uuid, &msTotalLengthCharUuid.u) == 0 ||
+      ble_uuid_cmp(uuid, &msTrackNumberCharUuid.u) == 0 || ble_uuid_cmp(uuid, &msTrackTotalCharUuid.u) == 0 ||
+      ble_uuid_cmp(uuid, &msPlaybackSpeedCharUuid.u) == 0) {
+    auto value = static_cast<int>(reader.ReadUint32BigEndian());
+    if (!reader.Ok()) {
+      return 0;
+    }
+    if (ble_uuid_cmp(uuid, &msPositionCharUuid.u) == 0) {
+      trackProgress = value;
       trackProgressUpdateTime = xTaskGetTickCount();
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msTotalLengthCharUuid.u) == 0) {
-      trackLength = (s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msTrackNumberCharUuid.u) == 0) {
-      trackNumber = (s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msTrackTotalCharUuid.u) == 0) {
-      tracksTotal = (s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
-    } else if (ble_uuid_cmp(ctxt->chr->uuid, &msPlaybackSpeedCharUuid.u) == 0) {
-      playbackSpeed = static_cast<float>(((s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3])) / 100.0f;
+    } else if (ble_uuid_cmp(uuid, &msTotalLengthCharUuid.u) == 0) {
+      trackLength = value;
+    } else if (ble_uuid_cmp(uuid, &msTrackNumberCharUuid.u) == 0) {
+      trackNumber = value;
+    } else if (ble_uuid_cmp(uuid, &msTrackTotalCharUuid.u) == 0) {
+      tracksTotal = value;
+    } else {
+      playbackSpeed = static_cast<float>(value) / 100.0f;
     }
+    return 0;
+  }
+
+  // Strings
+  size_t notifSize = reader.Remaining();
+  char data[MaxStringSize + 1];
+  size_t bufferSize = reader.ReadUpTo(data, MaxStringSize);
+
+  if (notifSize > bufferSize) {
+    data[bufferSize - 1] = '.';
+    data[bufferSize - 2] = '.';
+    data[bufferSize - 3] = '.';
+  }
+  data[bufferSize] = '\0';
+
+  if (ble_uuid_cmp(uuid, &msArtistCharUuid.u) == 0) {
+    artistName = data;
+  } else if (ble_uuid_cmp(uuid, &msTrackCharUuid.u) == 0) {
+    trackName = data;
+  } else if (ble_uuid_cmp(uuid, &msAlbumCharUuid.u) == 0) {
+    albumName = data;
   }
   return 0;
 }
@@ -17,6 +17,7 @@
 */
 
 #include "components/ble/NavigationService.h"
+#include "components/ble/MbufReader.h"
 
 namespace {
   // 0001yyxx-78fc-48fe-8e23-433b3a1942d0
@@ -82,19 +83,15 @@ void Pinetime::Controllers::NavigationService::Init() {
 int Pinetime::Controllers::NavigationService::OnCommand(struct ble_gatt_access_ctxt* ctxt) {
 
   if (ctxt->op == BLE_GATT_ACCESS_OP_WRITE_CHR) {
-    size_t notifSize = OS_MBUF_PKTLEN(ctxt->om);
-    uint8_t data[notifSize + 1];
-    data[notifSize] = '\0';
-    os_mbuf_copydata(ctxt->om, 0, notifSize, data);
-    char* s = (char*) &data[0];
+    MbufReader reader {ctxt->om};
     if (ble_uuid_cmp(ctxt->chr->uuid, &navFlagCharUuid.u) == 0) {
-      m_flag = s;
+      reader.ReadString(m_flag);
     } else if (ble_uuid_cmp(ctxt->chr->uuid, &navNarrativeCharUuid.u) == 0) {
-      m_narrative = s;
+      reader.ReadString(m_narrative);
     } else if (ble_uuid_cmp(ctxt->chr->uuid, &navManDistCharUuid.u) == 0) {
-      m_manDist = s;
+      reader.ReadString(m_manDist);
     } else if (ble_uuid_cmp(ctxt->chr->uuid, &navProgressCharUuid.u) == 0) {
-      m_progress = data[0];
+      m_progress = reader.ReadUint8();
     }
   }
   return 0;
@@ -22,6 +22,7 @@
 #include "components/ble/ServiceDiscovery.h"
 #include "components/ble/MotionService.h"
 #include "components/ble/SimpleWeatherService.h"
+#include "components/ble/FrameStatisticsService.h"
 #include "components/fs/FS.h"
 
 namespace Pinetime {
@@ -49,7 +50,8 @@ namespace Pinetime {
                        Pinetime::Drivers::SpiNorFlash& spiNorFlash,
                        HeartRateController& heartRateController,
                        MotionController& motionController,
-                       FS& fs);
+                       FS& fs,
+                       FrameStatistics& frameStatistics);
       void Init();
       void StartAdvertising();
       int OnGAPEvent(ble_gap_event* event);
@@ -106,6 +108,7 @@ namespace Pinetime {
       HeartRateService heartRateService;
       MotionService motionService;
       FSService fsService;
+      FrameStatisticsService frameStatisticsService;
       ServiceDiscovery serviceDiscovery;
 
       uint8_t addrType;
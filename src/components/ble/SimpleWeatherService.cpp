@@ -17,6 +17,7 @@
 */
 
 #include "components/ble/SimpleWeatherService.h"
+#include "components/ble/MbufReader.h"
 
 #include <algorithm>
 #include <array>
@@ -28,52 +29,43 @@ using namespace Pinetime::Controllers;
 namespace {
   enum class MessageType : uint8_t { CurrentWeather, Forecast, Unknown };
 
-  uint64_t ToUInt64(const uint8_t* data) {
-    return data[0] + (data[1] << 8) + (data[2] << 16) + (data[3] << 24) + (static_cast<uint64_t>(data[4]) << 32) +
-           (static_cast<uint64_t>(data[5]) << 40) + (static_cast<uint64_t>(data[6]) << 48) + (static_cast<uint64_t>(data[7]) << 56);
-  }
-
-  int16_t ToInt16(const uint8_t* data) {
-    return data[0] + (data[1] << 8);
-  }
-
-  SimpleWeatherService::CurrentWeather CreateCurrentWeather(const uint8_t* dataBuffer) {
+  SimpleWeatherService::CurrentWeather CreateCurrentWeather(MbufReader& reader) {
+    auto timestamp = reader.ReadUint64();
+    auto temperature = static_cast<int16_t>(reader.ReadUint16());
+    auto minTemperature = static_cast<int16_t>(reader.ReadUint16());
+    auto maxTemperature = static_cast<int16_t>(reader.ReadUint16());
     SimpleWeatherService::Location cityName;
-    std::memcpy(cityName.data(), &dataBuffer[16], 32);
+    reader.Read(cityName.data(), 32);
     cityName[32] = '\0';
-    return SimpleWeatherService::CurrentWeather(ToUInt64(&dataBuffer[2]),
-                                                ToInt16(&dataBuffer[10]),
-                                                ToInt16(&dataBuffer[12]),
-                                                ToInt16(&dataBuffer[14]),
-                                                SimpleWeatherService::Icons {dataBuffer[16 + 32]},
+    return SimpleWeatherService::CurrentWeather(timestamp,
+                                                temperature,
+                                                minTemperature,
+                                                maxTemperature,
+                                                SimpleWeatherService::Icons {reader.ReadUint8()},
                                                 std::move(cityName));
   }
 
-  SimpleWeatherService::Forecast CreateForecast(const uint8_t* dataBuffer) {
-    auto timestamp = static_cast<uint64_t>(ToUInt64(&dataBuffer[2]));
+  SimpleWeatherService::Forecast CreateForecast(MbufReader& reader) {
+    auto timestamp = reader.ReadUint64();
 
     std::array<SimpleWeatherService::Forecast::Day, SimpleWeatherService::MaxNbForecastDays> days;
-    const uint8_t nbDaysInBuffer = dataBuffer[10];
+    const uint8_t nbDaysInBuffer = reader.ReadUint8();
     const uint8_t nbDays = std::min(SimpleWeatherService::MaxNbForecastDays, nbDaysInBuffer);
     for (int i = 0; i < nbDays; i++) {
-      days[i] = SimpleWeatherService::Forecast::Day {ToInt16(&dataBuffer[11 + (i * 5)]),
-                                                     ToInt16(&dataBuffer[13 + (i * 5)]),
-                                                     SimpleWeatherService::Icons {dataBuffer[15 + (i * 5)]}};
+      auto minTemperature = static_cast<int16_t>(reader.ReadUint16());
+      auto maxTemperature = static_cast<int16_t>(reader.ReadUint16());
+      days[i] = SimpleWeatherService::Forecast::Day {minTemperature, maxTemperature, SimpleWeatherService::Icons {reader.ReadUint8()}};
     }
     return SimpleWeatherService::Forecast {timestamp, nbDays, days};
   }
 
-  MessageType GetMessageType(const uint8_t* data) {
-    auto messageType = static_cast<MessageType>(*data);
+  MessageType GetMessageType(uint8_t data) {
+    auto messageType = static_cast<MessageType>(data);
     if (messageType > MessageType::Unknown) {
       return MessageType::Unknown;
     }
     return messageType;
   }
-
-  uint8_t GetVersion(const uint8_t* dataBuffer) {
-    return dataBuffer[1];
-  }
 }
 
 int WeatherCallback(uint16_t /*connHandle*/, uint16_t /*attrHandle*/, struct ble_gatt_access_ctxt* ctxt, void* arg) {
@@ -89,13 +81,19 @@ void SimpleWeatherService::Init() {
 }
 
 int SimpleWeatherService::OnCommand(struct ble_gatt_access_ctxt* ctxt) {
-  const auto* buffer = ctxt->om;
-  const auto* dataBuffer = buffer->om_data;
+  MbufReader reader {ctxt->om};
+  auto messageType = GetMessageType(reader.ReadUint8());
+  auto version = reader.ReadUint8();
 
-  switch (GetMessageType(dataBuffer)) {
+  switch (messageType) {
     case MessageType::CurrentWeather:
-      if (GetVersion(dataBuffer) == 0) {
-        currentWeather = CreateCurrentWeather(dataBuffer);
+      if (version == 0) {
+        auto weather = CreateCurrentWeather(reader);
+        if (!reader.Ok()) {
+          NRF_LOG_INFO("Current weather : invalid message length");
+          break;
+        }
+        currentWeather = std::move(weather);
         NRF_LOG_INFO("Current weather :\n\tTimestamp : %d\n\tTemperature:%d\n\tMin:%d\n\tMax:%d\n\tIcon:%d\n\tLocation:%s",
                      currentWeather->timestamp,
                      currentWeather->temperature,
@@ -106,8 +104,13 @@ int SimpleWeatherService::OnCommand(struct ble_gatt_access_ctxt* ctxt) {
       }
       break;
     case MessageType::Forecast:
-      if (GetVersion(dataBuffer) == 0) {
-        forecast = CreateForecast(dataBuffer);
+      if (version == 0) {
+        auto newForecast = CreateForecast(reader);
+        if (!reader.Ok()) {
+          NRF_LOG_INFO("Forecast : invalid message length");
+          break;
+        }
+        forecast = newForecast;
         NRF_LOG_INFO("Forecast : Timestamp : %d", forecast->timestamp);
         for (int i = 0; i < 5; i++) {
           NRF_LOG_INFO("\t[%d] Min: %d - Max : %d - Icon : %d",
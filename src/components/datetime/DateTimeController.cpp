@@ -1,4 +1,6 @@
 #include "components/datetime/DateTimeController.h"
+#include <algorithm>
+#include <hal/nrf_rtc.h>
 #include <libraries/log/nrf_log.h>
 #include <systemtask/SystemTask.h>
 
@@ -9,14 +11,22 @@ namespace {
   char const* DaysStringShortLow[] = {"--", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
   char const* MonthsString[] = {"--", "JAN", "FEB", "MAR", "APR", "MAY", "JUN", "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
   char const* MonthsStringLow[] = {"--", "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+  void TimeEventTimerCallback(TimerHandle_t xTimer) {
+    auto* systemTask = static_cast<Pinetime::System::SystemTask*>(pvTimerGetTimerID(xTimer));
+    systemTask->PushMessage(Pinetime::System::Messages::TimeEventTimerExpired);
+  }
 }
 
 DateTime::DateTime(Controllers::Settings& settingsController) : settingsController {settingsController} {
 }
 
 void DateTime::SetCurrentTime(std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> t) {
-  this->currentDateTime = t;
-  UpdateTime(previousSystickCounter); // Update internal state without updating the time
+  taskENTER_CRITICAL();
+  currentDateTime = t;
+  isTimeChanged = true;
+  taskEXIT_CRITICAL();
+  NotifyTimeEventChanged();
 }
 
 void DateTime::SetTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second) {
@@ -30,12 +40,16 @@ void DateTime::SetTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour,
   };
 
   tm.tm_isdst = -1; // Use DST value from local time zone
-  currentDateTime = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+  const auto t = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+  taskENTER_CRITICAL();
+  currentDateTime = t;
+  isTimeChanged = true;
+  taskEXIT_CRITICAL();
 
   NRF_LOG_INFO("%d %d %d ", day, month, year);
   NRF_LOG_INFO("%d %d %d ", hour, minute, second);
 
-  UpdateTime(previousSystickCounter);
+  NotifyTimeEventChanged();
 
   systemTask->PushMessage(System::Messages::OnNewTime);
 }
@@ -66,43 +80,138 @@ void DateTime::UpdateTime(uint32_t systickCounter) {
     previousSystickCounter = 0xffffff - (rest - systickCounter);
   }
 
+  // The fields below are also written by SetTime(), SetAlarm() and CancelAlarm() from other tasks
+  taskENTER_CRITICAL();
   currentDateTime += std::chrono::seconds(correctedDelta);
-  uptime += std::chrono::seconds(correctedDelta);
+  const auto now = currentDateTime;
+  const bool timeChanged = isTimeChanged;
+  const bool alarmReached = isAlarmSet && now >= alarmTime;
+  bool mustReschedule = isScheduleRequested || timeChanged || alarmReached;
+  isTimeChanged = false;
+  isScheduleRequested = false;
+  if (alarmReached) {
+    isAlarmSet = false;
+  }
+  taskEXIT_CRITICAL();
 
-  std::time_t currentTime = std::chrono::system_clock::to_time_t(currentDateTime);
-  localTime = *std::localtime(&currentTime);
+  uptime += std::chrono::seconds(correctedDelta);
 
-  auto minute = Minutes();
-  auto hour = Hours();
+  if (timeChanged) {
+    OnTimeChanged();
+  } else if (correctedDelta > 0) {
+    // The calendar conversion is only needed when the hour changes, the minutes and seconds are updated in place
+    const uint32_t secondsInHour = localTime.tm_min * 60 + localTime.tm_sec + correctedDelta;
+    if (secondsInHour < 3600) {
+      localTime.tm_min = secondsInHour / 60;
+      localTime.tm_sec = secondsInHour % 60;
+    } else {
+      UpdateLocalTime();
+    }
 
-  if (minute == 0 && !isHourAlreadyNotified) {
-    isHourAlreadyNotified = true;
-    if (systemTask != nullptr) {
-      systemTask->PushMessage(System::Messages::OnNewHour);
+    if (now >= nextHalfHour) {
+      const auto minuteOfDay = (SecondsSinceEpoch(nextHalfHour) % secondsPerDay) / 60;
+      if (systemTask != nullptr) {
+        if (minuteOfDay % 60 == 0) {
+          systemTask->PushMessage(System::Messages::OnNewHour);
+        }
+        systemTask->PushMessage(System::Messages::OnNewHalfHour);
+        // Notify new day to SystemTask
+        if (minuteOfDay == 0) {
+          systemTask->PushMessage(System::Messages::OnNewDay);
+        }
+      }
+      mustReschedule = true;
     }
-  } else if (minute != 0) {
-    isHourAlreadyNotified = false;
   }
 
-  if ((minute == 0 || minute == 30) && !isHalfHourAlreadyNotified) {
-    isHalfHourAlreadyNotified = true;
-    if (systemTask != nullptr) {
-      systemTask->PushMessage(System::Messages::OnNewHalfHour);
-    }
-  } else if (minute != 0 && minute != 30) {
-    isHalfHourAlreadyNotified = false;
+  if (alarmReached && systemTask != nullptr) {
+    systemTask->PushMessage(System::Messages::SetOffAlarm);
+  }
+
+  if (mustReschedule) {
+    ScheduleTimeEvent();
+  }
+}
+
+void DateTime::SetAlarm(std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> t) {
+  taskENTER_CRITICAL();
+  alarmTime = t;
+  isAlarmSet = true;
+  isScheduleRequested = true;
+  taskEXIT_CRITICAL();
+  NotifyTimeEventChanged();
+}
+
+void DateTime::CancelAlarm() {
+  taskENTER_CRITICAL();
+  isAlarmSet = false;
+  isScheduleRequested = true;
+  taskEXIT_CRITICAL();
+  NotifyTimeEventChanged();
+}
+
+void DateTime::NotifyTimeEventChanged() {
+  // The timer is rescheduled by UpdateTime(), which SystemTask runs after each message
+  if (systemTask != nullptr) {
+    systemTask->PushMessage(System::Messages::TimeEventChanged);
   }
+}
+
+std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> DateTime::CurrentDateTime() const {
+  taskENTER_CRITICAL();
+  const auto t = currentDateTime;
+  taskEXIT_CRITICAL();
+  return t;
+}
+
+std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> DateTime::UTCDateTime() const {
+  return CurrentDateTime() - std::chrono::seconds((tzOffset + dstOffset) * 15 * 60);
+}
 
-  // Notify new day to SystemTask
-  if (hour == 0 and not isMidnightAlreadyNotified) {
-    isMidnightAlreadyNotified = true;
-    if (systemTask != nullptr)
-      systemTask->PushMessage(System::Messages::OnNewDay);
-  } else if (hour != 0) {
-    isMidnightAlreadyNotified = false;
+void DateTime::UpdateLocalTime() {
+  std::time_t currentTime = std::chrono::system_clock::to_time_t(CurrentDateTime());
+  localTime = *std::localtime(&currentTime);
+}
+
+void DateTime::OnTimeChanged() {
+  const auto previousYear = localTime.tm_year;
+  const auto previousDay = localTime.tm_yday;
+  UpdateLocalTime();
+  if ((localTime.tm_year != previousYear || localTime.tm_yday != previousDay) && systemTask != nullptr) {
+    systemTask->PushMessage(System::Messages::OnNewDay);
   }
 }
 
+uint32_t DateTime::SecondsSinceEpoch(std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> t) {
+  return std::chrono::duration_cast<std::chrono::seconds>(t.time_since_epoch()).count();
+}
+
+void DateTime::ScheduleTimeEvent() {
+  taskENTER_CRITICAL();
+  const auto now = currentDateTime;
+  const bool alarmSet = isAlarmSet;
+  const auto alarm = alarmTime;
+  taskEXIT_CRITICAL();
+
+  const auto nextHalfHourSeconds = (SecondsSinceEpoch(now) / secondsPerHalfHour + 1) * secondsPerHalfHour;
+  nextHalfHour = std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>(std::chrono::seconds(nextHalfHourSeconds));
+
+  if (timeEventTimer == nullptr) {
+    return;
+  }
+
+  auto nextEvent = nextHalfHour;
+  if (alarmSet && alarm < nextEvent) {
+    nextEvent = alarm;
+  }
+
+  // currentDateTime corresponds to previousSystickCounter, the RTC has been running since then.
+  const uint32_t elapsedTicks = (nrf_rtc_counter_get(portNRF_RTC_REG) - previousSystickCounter) & portNRF_RTC_MAXTICKS;
+  const int64_t delayMs = std::chrono::duration_cast<std::chrono::milliseconds>(nextEvent - now).count();
+  const int64_t delayTicks = (delayMs * configTICK_RATE_HZ + 999) / 1000 - elapsedTicks;
+  xTimerChangePeriod(timeEventTimer, std::max<int64_t>(delayTicks, 1), 0);
+}
+
 const char* DateTime::MonthShortToString() const {
   return MonthsString[static_cast<uint8_t>(Month())];
 }
@@ -121,6 +230,9 @@ const char* DateTime::DayOfWeekShortToStringLow() const {
 
 void DateTime::Register(Pinetime::System::SystemTask* systemTask) {
   this->systemTask = systemTask;
+  timeEventTimer = xTimerCreate("timeEvent", 1, pdFALSE, systemTask, TimeEventTimerCallback);
+  UpdateLocalTime();
+  ScheduleTimeEvent();
 }
 
 using ClockType = Pinetime::Controllers::Settings::ClockType;
@@ -4,6 +4,9 @@
 #include <chrono>
 #include <ctime>
 #include <string>
+#include <FreeRTOS.h>
+#include <task.h>
+#include <timers.h>
 #include "components/settings/Settings.h"
 
 namespace Pinetime {
@@ -47,6 +50,17 @@ namespace Pinetime {
 
       void UpdateTime(uint32_t systickCounter);
 
+      /*
+       * The half hour boundaries (chimes, new hour and new day) and the alarm are notified to SystemTask
+       * by a single one-shot timer armed for the next of these events. The FreeRTOS tick is generated by the RTC
+       * and the tickless idle mode programs its compare register with the expiry of the next timer, so nothing
+       * runs between two events.
+       * The timer is only rescheduled from SystemTask: these methods can be called from any task, they record the
+       * alarm and wake SystemTask up.
+       */
+      void SetAlarm(std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> t);
+      void CancelAlarm();
+
       uint16_t Year() const {
         return 1900 + localTime.tm_year;
       }
@@ -124,13 +138,8 @@ namespace Pinetime {
       static const char* MonthShortToStringLow(Months month);
       const char* DayOfWeekShortToStringLow() const;
 
-      std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> CurrentDateTime() const {
-        return currentDateTime;
-      }
-
-      std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> UTCDateTime() const {
-        return currentDateTime - std::chrono::seconds((tzOffset + dstOffset) * 15 * 60);
-      }
+      std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> CurrentDateTime() const;
+      std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> UTCDateTime() const;
 
       std::chrono::seconds Uptime() const {
         return uptime;
@@ -149,9 +158,22 @@ namespace Pinetime {
       std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> currentDateTime;
       std::chrono::seconds uptime {0};
 
-      bool isMidnightAlreadyNotified = false;
-      bool isHourAlreadyNotified = true;
-      bool isHalfHourAlreadyNotified = true;
+      static constexpr uint32_t secondsPerHalfHour = 30 * 60;
+      static constexpr uint32_t secondsPerDay = 24 * 60 * 60;
+
+      std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> nextHalfHour;
+      std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> alarmTime;
+      bool isAlarmSet = false;
+      bool isScheduleRequested = false;
+      bool isTimeChanged = false;
+      TimerHandle_t timeEventTimer = nullptr;
+
+      void UpdateLocalTime();
+      void OnTimeChanged();
+      void ScheduleTimeEvent();
+      void NotifyTimeEventChanged();
+      static uint32_t SecondsSinceEpoch(std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> t);
+
       System::SystemTask* systemTask = nullptr;
       Controllers::Settings& settingsController;
     };
@@ -0,0 +1,72 @@
+#include "components/display/FrameStatistics.h"
+#include <algorithm>
+
+using namespace Pinetime::Controllers;
+
+void FrameStatistics::StartFrame(uint32_t timestamp) {
+  current = {};
+  frameStart = timestamp;
+}
+
+void FrameStatistics::EndFrame(uint32_t timestamp) {
+  // Refreshes with nothing to redraw are not frames
+  if (current.nbAreas == 0) {
+    return;
+  }
+
+  const uint32_t frameTime = timestamp - frameStart;
+  current.renderTime = (frameTime > current.flushTime) ? frameTime - current.flushTime : 0;
+
+  frames[0] = current;
+  frames++;
+  nbFrames = std::min(nbFrames + 1, historySize);
+}
+
+void FrameStatistics::StartFlush(uint32_t timestamp) {
+  flushStart = timestamp;
+}
+
+void FrameStatistics::EndFlush(uint32_t timestamp, uint32_t nbBytes, uint32_t nbTransactions) {
+  current.flushTime += timestamp - flushStart;
+  current.bytesSent += nbBytes;
+  current.nbTransactions += nbTransactions;
+  current.nbAreas++;
+}
+
+FrameStatistics::Summary FrameStatistics::RenderTime() const {
+  return Summarize(&Frame::renderTime);
+}
+
+FrameStatistics::Summary FrameStatistics::FlushTime() const {
+  return Summarize(&Frame::flushTime);
+}
+
+FrameStatistics::Summary FrameStatistics::BytesSent() const {
+  return Summarize(&Frame::bytesSent);
+}
+
+FrameStatistics::Summary FrameStatistics::NbAreas() const {
+  return Summarize(&Frame::nbAreas);
+}
+
+FrameStatistics::Summary FrameStatistics::NbTransactions() const {
+  return Summarize(&Frame::nbTransactions);
+}
+
+FrameStatistics::Summary FrameStatistics::Summarize(uint32_t Frame::*field) const {
+  if (nbFrames == 0) {
+    return {};
+  }
+
+  // The most recent frames are the last ones before the current index
+  Summary summary {UINT32_MAX, 0, 0};
+  uint32_t total = 0;
+  for (size_t i = 1; i <= nbFrames; i++) {
+    const uint32_t value = frames[historySize - i].*field;
+    summary.min = std::min(summary.min, value);
+    summary.max = std::max(summary.max, value);
+    total += value;
+  }
+  summary.avg = total / nbFrames;
+  return summary;
+}
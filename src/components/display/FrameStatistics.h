@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "utility/CircularBuffer.h"
+
+namespace Pinetime {
+  namespace Controllers {
+    // Records how each refresh of the display is spent (rendering by LVGL vs. flushing to the LCD).
+    // Timestamps are provided by the caller, in system ticks.
+    class FrameStatistics {
+    public:
+      struct Frame {
+        uint32_t renderTime;
+        uint32_t flushTime;
+        uint32_t bytesSent;
+        uint32_t nbAreas;
+        uint32_t nbTransactions;
+      };
+
+      struct Summary {
+        uint32_t min;
+        uint32_t avg;
+        uint32_t max;
+      };
+
+      void StartFrame(uint32_t timestamp);
+      void EndFrame(uint32_t timestamp);
+      void StartFlush(uint32_t timestamp);
+      void EndFlush(uint32_t timestamp, uint32_t nbBytes, uint32_t nbTransactions);
+
+      size_t NbFrames() const {
+        return nbFrames;
+      }
+
+      Summary RenderTime() const;
+      Summary FlushTime() const;
+      Summary BytesSent() const;
+      Summary NbAreas() const;
+      Summary NbTransactions() const;
+
+    private:
+      static constexpr size_t historySize = 32;
+      Utility::CircularBuffer<Frame, historySize> frames = {};
+      size_t nbFrames = 0;
+
+      Frame current = {};
+      uint32_t frameStart = 0;
+      uint32_t flushStart = 0;
+
+      Summary Summarize(uint32_t Frame::*field) const;
+    };
+  }
+}
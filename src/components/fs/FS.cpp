@@ -2,6 +2,8 @@
 #include <cstring>
 #include <littlefs/lfs.h>
 #include <lvgl/lvgl.h>
+#include <FreeRTOS.h>
+#include <task.h>
 
 using namespace Pinetime::Controllers;
 
@@ -20,12 +22,19 @@ FS::FS(Pinetime::Drivers::SpiNorFlash& driver)
       .block_count = size / blockSize,
       .block_cycles = 1000u,
 
-      .cache_size = 16,
-      .lookahead_size = 16,
+      .cache_size = cacheSize,
+      .lookahead_size = lookaheadSize,
+      .read_buffer = readBuffer,
+      .prog_buffer = progBuffer,
+      .lookahead_buffer = lookaheadBuffer,
 
       .name_max = 50,
       .attr_max = 50,
     } {
+  for (auto& fileCache : fileCaches) {
+    fileCache.config = {};
+    fileCache.config.buffer = fileCache.buffer;
+  }
 }
 
 void FS::Init() {
@@ -54,11 +63,22 @@ void FS::VerifyResource() {
 }
 
 int FS::FileOpen(lfs_file_t* file_p, const char* fileName, const int flags) {
-  return lfs_file_open(&lfs, file_p, fileName, flags);
+  FileCache* fileCache = AcquireFileCache();
+  if (fileCache == nullptr) {
+    return lfs_file_open(&lfs, file_p, fileName, flags);
+  }
+  int res = lfs_file_opencfg(&lfs, file_p, fileName, flags, &fileCache->config);
+  if (res < 0) {
+    ReleaseFileCache(&fileCache->config);
+  }
+  return res;
 }
 
 int FS::FileClose(lfs_file_t* file_p) {
-  return lfs_file_close(&lfs, file_p);
+  const lfs_file_config* config = file_p->cfg;
+  int res = lfs_file_close(&lfs, file_p);
+  ReleaseFileCache(config);
+  return res;
 }
 
 int FS::FileRead(lfs_file_t* file_p, uint8_t* buff, uint32_t size) {
@@ -73,6 +93,10 @@ int FS::FileSeek(lfs_file_t* file_p, uint32_t pos) {
   return lfs_file_seek(&lfs, file_p, pos, LFS_SEEK_SET);
 }
 
+int FS::FileSize(lfs_file_t* file_p) {
+  return lfs_file_size(&lfs, file_p);
+}
+
 int FS::FileDelete(const char* fileName) {
   return lfs_remove(&lfs, fileName);
 }
@@ -109,6 +133,30 @@ lfs_ssize_t FS::GetFSSize() {
   return lfs_fs_size(&lfs);
 }
 
+FS::FileCache* FS::AcquireFileCache() {
+  FileCache* result = nullptr;
+  taskENTER_CRITICAL();
+  for (auto& fileCache : fileCaches) {
+    if (!fileCache.used) {
+      fileCache.used = true;
+      result = &fileCache;
+      break;
+    }
+  }
+  taskEXIT_CRITICAL();
+  return result;
+}
+
+// Does nothing if config doesn't belong to the pool (file cache allocated by littlefs)
+void FS::ReleaseFileCache(const lfs_file_config* config) {
+  for (auto& fileCache : fileCaches) {
+    if (&fileCache.config == config) {
+      fileCache.used = false;
+      return;
+    }
+  }
+}
+
 /*
 
     ----------- Interface between littlefs and SpiNorFlash -----------
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include "drivers/SpiNorFlash.h"
 #include <littlefs/lfs.h>
@@ -17,6 +18,7 @@ namespace Pinetime {
       int FileRead(lfs_file_t* file_p, uint8_t* buff, uint32_t size);
       int FileWrite(lfs_file_t* file_p, const uint8_t* buff, uint32_t size);
       int FileSeek(lfs_file_t* file_p, uint32_t pos);
+      int FileSize(lfs_file_t* file_p);
 
       int FileDelete(const char* fileName);
 
@@ -68,11 +70,33 @@ namespace Pinetime {
       static constexpr size_t size = 0x34C000;
       static constexpr size_t blockSize = 4096;
 
+      // Size of the littlefs caches. Each of them is filled by a single SPI transaction, so a larger
+      // cache means fewer transactions, especially when a file is read in small chunks (lv_font_load()).
+      static constexpr size_t cacheSize = 256;
+      static constexpr size_t lookaheadSize = 64;
+      // Number of files that can be open at the same time with a cache from the pool.
+      // The cache of other files is allocated on the heap.
+      static constexpr size_t nbFileCaches = 2;
+
+      struct FileCache {
+        lfs_file_config config;
+        uint8_t buffer[cacheSize];
+        bool used = false;
+      };
+
       bool resourcesValid = false;
       const struct lfs_config lfsConfig;
 
       lfs_t lfs;
 
+      uint8_t readBuffer[cacheSize];
+      uint8_t progBuffer[cacheSize];
+      uint32_t lookaheadBuffer[lookaheadSize / sizeof(uint32_t)];
+      std::array<FileCache, nbFileCaches> fileCaches;
+
+      FileCache* AcquireFileCache();
+      void ReleaseFileCache(const lfs_file_config* config);
+
       static int SectorSync(const struct lfs_config* c);
       static int SectorErase(const struct lfs_config* c, lfs_block_t block);
       static int SectorProg(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, const void* buffer, lfs_size_t size);
@@ -1,65 +1,90 @@
 #include "components/heartrate/Ppg.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <nrf_log.h>
 #include <vector>
 
 using namespace Pinetime::Controllers;
 
 namespace {
-  float LinearInterpolation(const float* xValues, const float* yValues, int length, float pointX) {
-    if (pointX > xValues[length - 1]) {
-      return yValues[length - 1];
-    } else if (pointX <= xValues[0]) {
-      return yValues[0];
+  constexpr int dataLength = Ppg::dataLength;
+  constexpr int spectrumLength = Ppg::spectrumLength;
+
+  using FixedTraits = PpgTraits<int16_t>;
+
+  int16_t Saturate(int32_t value) {
+    return static_cast<int16_t>(std::clamp<int32_t>(value, INT16_MIN, INT16_MAX));
+  }
+
+  // Rounded product of value and a fixed point factor
+  int32_t Multiply(int32_t value, int32_t factor) {
+    return (value * factor + (1 << (FixedTraits::factorFractionBits - 1))) >> FixedTraits::factorFractionBits;
+  }
+
+  uint32_t SquareRoot(uint64_t value) {
+    uint64_t root = 0;
+    uint64_t bit = static_cast<uint64_t>(1) << 62;
+    while (bit > value) {
+      bit >>= 2;
     }
-    int index = 0;
-    while (pointX > xValues[index] && index < length - 1) {
-      index++;
+    while (bit != 0) {
+      if (value >= root + bit) {
+        value -= root + bit;
+        root = (root >> 1) + bit;
+      } else {
+        root >>= 1;
+      }
+      bit >>= 2;
     }
-    float pointX0 = xValues[index - 1];
-    float pointX1 = xValues[index];
-    float pointY0 = yValues[index - 1];
-    float pointY1 = yValues[index];
-    float mu = (pointX - pointX0) / (pointX1 - pointX0);
+    return static_cast<uint32_t>(root);
+  }
 
-    return (pointY0 * (1 - mu) + pointY1 * mu);
+  // Position of a threshold crossing between bins idx and idx + 1, distance being the difference
+  // between the threshold and the value of bin idx, and span the difference between both bins.
+  float Crossing(int idx, float distance, float span) {
+    return static_cast<float>(idx) + distance / span;
   }
 
-  float PeakSearch(float* xVals, float* yVals, float threshold, float& width, float start, float end, int length) {
+  int32_t Crossing(int idx, int32_t distance, int32_t span) {
+    return (idx << FixedTraits::binsFractionBits) +
+           static_cast<int32_t>((static_cast<int64_t>(distance) << FixedTraits::binsFractionBits) / span);
+  }
+
+  // Searches the spectrum, linearly interpolated between bins, for a single peak above threshold in the bins [start, end).
+  // The threshold crossings are computed analytically on each bin segment. A peak only counts once the spectrum
+  // has been below threshold within the search range. Returns the peak center (bins) halfway between the rising
+  // and falling crossings and sets width to the distance between them, or 0 if there isn't exactly one peak.
+  template <typename Magnitude, typename Bins>
+  Bins PeakSearch(const Magnitude* yVals, Magnitude threshold, Bins& width, int start, int end, int length) {
     int peaks = 0;
     bool enabled = false;
-    float minBin = 0.0f;
-    float maxBin = 0.0f;
-    float peakCenter = 0.0f;
-    float prevValue = LinearInterpolation(xVals, yVals, length, start - 0.01f);
-    float currValue = LinearInterpolation(xVals, yVals, length, start);
-    float idx = start;
-    while (idx < end) {
-      float nextValue = LinearInterpolation(xVals, yVals, length, idx + 0.01f);
+    Bins minBin = 0;
+    Bins peakCenter = 0;
+    int last = std::min(end, length - 1);
+    for (int idx = start; idx < last; idx++) {
+      Magnitude currValue = yVals[idx];
+      Magnitude nextValue = yVals[idx + 1];
       if (currValue < threshold) {
         enabled = true;
-      }
-      if (currValue >= threshold and enabled) {
-        if (prevValue < threshold) {
-          minBin = idx;
-        } else if (nextValue <= threshold) {
-          maxBin = idx;
-          peaks++;
-          width = maxBin - minBin;
-          peakCenter = width / 2.0f + minBin;
+        if (nextValue >= threshold) {
+          minBin = Crossing(idx, threshold - currValue, nextValue - currValue);
         }
+      } else if (enabled && currValue > threshold && nextValue <= threshold) {
+        Bins maxBin = Crossing(idx, currValue - threshold, currValue - nextValue);
+        peaks++;
+        width = maxBin - minBin;
+        peakCenter = width / 2 + minBin;
       }
-      prevValue = currValue;
-      currValue = nextValue;
-      idx += 0.01f;
     }
     if (peaks != 1) {
-      width = 0.0f;
-      peakCenter = 0.0f;
+      width = 0;
+      peakCenter = 0;
     }
     return peakCenter;
   }
 
-  float SpectrumMean(const std::array<float, Ppg::spectrumLength>& signal, int start, int end) {
+  float SpectrumMean(const std::array<float, spectrumLength>& signal, int start, int end) {
     int total = 0;
     float mean = 0.0f;
     for (int idx = start; idx < end; idx++) {
@@ -72,19 +97,97 @@ namespace {
     return mean;
   }
 
-  float SignalToNoise(const std::array<float, Ppg::spectrumLength>& signal, int start, int end, float max) {
+  bool AboveNoiseLevel(const std::array<float, spectrumLength>& signal, int start, int end, float max, float threshold) {
     float mean = SpectrumMean(signal, start, end);
-    return max / mean;
+    return max / mean > threshold;
+  }
+
+  // Same as max / mean > threshold, without division
+  bool AboveNoiseLevel(const std::array<int32_t, spectrumLength>& signal, int start, int end, int32_t max, int32_t threshold) {
+    int64_t sum = 0;
+    for (int idx = start; idx < end; idx++) {
+      sum += signal[idx];
+    }
+    return (static_cast<int64_t>(max) * (end - start) << FixedTraits::factorFractionBits) > sum * threshold;
+  }
+
+  template <typename Magnitude>
+  Magnitude SpectrumMax(const std::array<Magnitude, spectrumLength>& data, int start, int end) {
+    Magnitude max = 0;
+    for (int idx = start; idx < end; idx++) {
+      if (data.at(idx) > max) {
+        max = data.at(idx);
+      }
+    }
+    return max;
+  }
+
+  // Copies the ring buffer starting at head into signal, then removes the linear trend
+  // and differentiates the signal. Returns the scale of the signal (0).
+  int Detrend(const std::array<uint16_t, dataLength>& data, uint16_t head, std::array<float, dataLength>& signal) {
+    auto next = std::copy(data.begin() + head, data.end(), signal.begin());
+    std::copy(data.begin(), data.begin() + head, next);
+
+    int size = signal.size();
+    float offset = signal.front();
+    float slope = (signal.at(size - 1) - offset) / static_cast<float>(size - 1);
+
+    for (int idx = 0; idx < size; idx++) {
+      signal[idx] -= (slope * static_cast<float>(idx) + offset);
+    }
+    for (int idx = 0; idx < size - 1; idx++) {
+      signal[idx] = signal[idx + 1] - signal[idx];
+    }
+    return 0;
   }
 
+  // Same as above, in Q15. The difference of the detrended signal is computed exactly, multiplied by
+  // (dataLength - 1), then scaled by 2^scale so that its maximum uses 14 bits, leaving room for the filter.
+  // Returns the scale.
+  int Detrend(const std::array<uint16_t, dataLength>& data, uint16_t head, std::array<int16_t, dataLength>& signal) {
+    constexpr int mask = dataLength - 1;
+    int32_t trend = data[(head + dataLength - 1) & mask] - data[head];
+    auto difference = [&data, head, trend](int idx) {
+      return (dataLength - 1) * (data[(head + idx + 1) & mask] - data[(head + idx) & mask]) - trend;
+    };
+
+    int32_t max = 0;
+    for (int idx = 0; idx < dataLength - 1; idx++) {
+      max = std::max(max, std::abs(difference(idx)));
+    }
+    int scale = 0;
+    if (max > 0) {
+      while ((max >> -scale) >= (1 << 14)) {
+        scale--;
+      }
+      while (scale >= 0 && (max << scale) < (1 << 13)) {
+        scale++;
+      }
+    }
+
+    for (int idx = 0; idx < dataLength - 1; idx++) {
+      int32_t value = difference(idx);
+      if (scale >= 0) {
+        signal[idx] = static_cast<int16_t>(value << scale);
+      } else {
+        signal[idx] = static_cast<int16_t>((value + (1 << (-scale - 1))) >> -scale);
+      }
+    }
+    signal[dataLength - 1] = 0;
+    return scale;
+  }
+
+  // 0.268 is ~0.5Hz and 0.816 is ~4Hz cutoff at 10Hz sampling
+  constexpr float lowPassAlpha = 0.816f;
+  constexpr float highPassAlpha = 0.268f;
+
   // Simple bandpass filter using exponential moving average
-  void Filter30to240(std::array<float, Ppg::dataLength>& signal) {
+  void Filter30to240(std::array<float, dataLength>& signal) {
     // From:
     // https://www.norwegiancreations.com/2016/03/arduino-tutorial-simple-high-pass-band-pass-and-band-stop-filtering/
 
     int length = signal.size();
-    // 0.268 is ~0.5Hz and 0.816 is ~4Hz cutoff at 10Hz sampling
-    float expAlpha = 0.816f;
+    float expAlpha = lowPassAlpha;
     float expAvg = 0.0f;
     for (int loop = 0; loop < 4; loop++) {
       expAvg = signal.front();
@@ -93,7 +196,7 @@ namespace {
         signal[idx] = expAvg;
       }
     }
-    expAlpha = 0.268f;
+    expAlpha = highPassAlpha;
     for (int loop = 0; loop < 4; loop++) {
       expAvg = signal.front();
       for (int idx = 0; idx < length; idx++) {
@@ -103,26 +206,34 @@ namespace {
     }
   }
 
-  float SpectrumMax(const std::array<float, Ppg::spectrumLength>& data, int start, int end) {
-    float max = 0.0f;
-    for (int idx = start; idx < end; idx++) {
-      if (data.at(idx) > max) {
-        max = data.at(idx);
-      }
-    }
-    return max;
+  // The moving averages keep filterExtraBits more fractional bits than the signal
+  constexpr int filterExtraBits = 8;
+
+  int64_t MovingAverage(int64_t average, int16_t value, int64_t alpha) {
+    int64_t delta = (static_cast<int64_t>(value) << filterExtraBits) - average;
+    return average + ((delta * alpha + (1 << (FixedTraits::factorFractionBits - 1))) >> FixedTraits::factorFractionBits);
   }
 
-  void Detrend(std::array<float, Ppg::dataLength>& signal) {
-    int size = signal.size();
-    float offset = signal.front();
-    float slope = (signal.at(size - 1) - offset) / static_cast<float>(size - 1);
+  int32_t AverageToSample(int64_t average) {
+    return static_cast<int32_t>((average + (1 << (filterExtraBits - 1))) >> filterExtraBits);
+  }
 
-    for (int idx = 0; idx < size; idx++) {
-      signal[idx] -= (slope * static_cast<float>(idx) + offset);
+  void Filter30to240(std::array<int16_t, dataLength>& signal) {
+    constexpr int64_t lowPass = FixedTraits::ToFactor(lowPassAlpha);
+    constexpr int64_t highPass = FixedTraits::ToFactor(highPassAlpha);
+    for (int loop = 0; loop < 4; loop++) {
+      int64_t expAvg = static_cast<int64_t>(signal.front()) << filterExtraBits;
+      for (auto& value : signal) {
+        expAvg = MovingAverage(expAvg, value, lowPass);
+        value = static_cast<int16_t>(AverageToSample(expAvg));
+      }
     }
-    for (int idx = 0; idx < size - 1; idx++) {
-      signal[idx] = signal[idx + 1] - signal[idx];
+    for (int loop = 0; loop < 4; loop++) {
+      int64_t expAvg = static_cast<int64_t>(signal.front()) << filterExtraBits;
+      for (auto& value : signal) {
+        expAvg = MovingAverage(expAvg, value, highPass);
+        value = Saturate(value - AverageToSample(expAvg));
+      }
     }
   }
 
@@ -130,21 +241,240 @@ namespace {
   // Note: Harcoded and must be updated if constexpr dataLength is changed. Prevents the need to
   // use cosf() which results in an extra ~5KB in storage.
   // This data is symetrical so just using the first half (saves 128B when dataLength is 64).
-  static constexpr float hanning[Ppg::dataLength >> 1] {
+  static constexpr float hanning[dataLength >> 1] {
     0.0f,        0.00248461f, 0.00991376f, 0.0222136f,  0.03926189f, 0.06088921f, 0.08688061f, 0.11697778f,
     0.15088159f, 0.1882551f,  0.22872687f, 0.27189467f, 0.31732949f, 0.36457977f, 0.41317591f, 0.46263495f,
     0.51246535f, 0.56217185f, 0.61126047f, 0.65924333f, 0.70564355f, 0.75f,       0.79187184f, 0.83084292f,
     0.86652594f, 0.89856625f, 0.92664544f, 0.95048443f, 0.96984631f, 0.98453864f, 0.99441541f, 0.99937846f};
+
+  constexpr std::array<int16_t, (dataLength >> 1)> MakeFixedHanning() {
+    std::array<int16_t, (dataLength >> 1)> coefficients {};
+    for (int idx = 0; idx < (dataLength >> 1); idx++) {
+      coefficients[idx] = static_cast<int16_t>(FixedTraits::ToFactor(hanning[idx]));
+    }
+    return coefficients;
+  }
+
+  constexpr std::array<int16_t, (dataLength >> 1)> fixedHanning = MakeFixedHanning();
+
+  float ApplyWindow(float value, int hannIdx) {
+    return value * hanning[hannIdx];
+  }
+
+  int16_t ApplyWindow(int16_t value, int hannIdx) {
+    return static_cast<int16_t>(Multiply(value, fixedHanning[hannIdx]));
+  }
+
+  template <typename Sample>
+  void HanningWindow(std::array<Sample, dataLength>& signal) {
+    int hannIdx = 0;
+    for (int idx = 0; idx < dataLength; idx++) {
+      if (idx >= dataLength >> 1) {
+        hannIdx--;
+      }
+      signal[idx] = ApplyWindow(signal[idx], hannIdx);
+      if (idx < dataLength >> 1) {
+        hannIdx++;
+      }
+    }
+  }
+
+  // Taylor series of sin(x), only evaluated at compile time (|x| <= pi)
+  constexpr double Sine(double x) {
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 12; n++) {
+      term *= -x * x / static_cast<double>((2 * n) * (2 * n + 1));
+      sum += term;
+    }
+    return sum;
+  }
+
+  // FFT twiddle factors exp(-2*pi*i*k/dataLength) for k in [0, dataLength/2).
+  // Generated at compile time so neither cosf() nor a runtime trigonometric recurrence is needed.
+  template <typename T>
+  struct Twiddles {
+    std::array<T, spectrumLength> cos;
+    std::array<T, spectrumLength> sin;
+  };
+
+  constexpr Twiddles<float> MakeTwiddles() {
+    constexpr double pi = 3.14159265358979323846;
+    Twiddles<float> twiddles {};
+    for (int k = 0; k < spectrumLength; k++) {
+      double angle = 2.0 * pi * static_cast<double>(k) / static_cast<double>(dataLength);
+      twiddles.cos[k] = static_cast<float>(Sine(pi / 2.0 - angle));
+      twiddles.sin[k] = static_cast<float>(Sine(angle <= pi / 2.0 ? angle : pi - angle));
+    }
+    return twiddles;
+  }
+
+  constexpr Twiddles<float> twiddles = MakeTwiddles();
+
+  constexpr Twiddles<int32_t> MakeFixedTwiddles() {
+    Twiddles<int32_t> fixed {};
+    for (int k = 0; k < spectrumLength; k++) {
+      fixed.cos[k] = FixedTraits::ToFactor(twiddles.cos[k]);
+      fixed.sin[k] = FixedTraits::ToFactor(twiddles.sin[k]);
+    }
+    return fixed;
+  }
+
+  constexpr Twiddles<int32_t> fixedTwiddles = MakeFixedTwiddles();
+
+  // Bit reversal permutation of the complex values (interleaved real and imaginary parts) of z
+  template <typename Sample>
+  void BitReversal(Sample* z, int points) {
+    for (int idx = 1, rev = 0; idx < points; idx++) {
+      int bit = points >> 1;
+      while (rev & bit) {
+        rev ^= bit;
+        bit >>= 1;
+      }
+      rev |= bit;
+      if (idx < rev) {
+        std::swap(z[2 * idx], z[2 * rev]);
+        std::swap(z[2 * idx + 1], z[2 * rev + 1]);
+      }
+    }
+  }
+
+  // Magnitude spectrum of the real signal in data, computed in place. onBin(bin, magnitude) is called
+  // for each of the spectrumLength bins.
+  // The signal is processed as a dataLength/2 points complex FFT (even samples as real part,
+  // odd samples as imaginary part) which is then split into the spectrum of the real signal:
+  // X[k] = (Z[k] + conj(Z[N-k])) / 2 - i * exp(-2*pi*i*k/dataLength) * (Z[k] - conj(Z[N-k])) / 2
+  // Bins k and N-k depend on the same pair of values, so both are computed together.
+  template <typename OnBin>
+  void MagnitudeSpectrum(std::array<float, dataLength>& data, int /*scale*/, OnBin&& onBin) {
+    constexpr int points = spectrumLength;
+    float* z = data.data();
+    BitReversal(z, points);
+
+    // Radix-2 butterflies. The twiddles for a span of 'size' points are every (dataLength / size) entry of the table.
+    for (int size = 2; size <= points; size <<= 1) {
+      int half = size >> 1;
+      int step = dataLength / size;
+      for (int start = 0; start < points; start += size) {
+        for (int k = 0; k < half; k++) {
+          float wr = twiddles.cos[k * step];
+          float wi = -twiddles.sin[k * step];
+          int a = 2 * (start + k);
+          int b = 2 * (start + k + half);
+          float tr = z[b] * wr - z[b + 1] * wi;
+          float ti = z[b] * wi + z[b + 1] * wr;
+          z[b] = z[a] - tr;
+          z[b + 1] = z[a + 1] - ti;
+          z[a] += tr;
+          z[a + 1] += ti;
+        }
+      }
+    }
+
+    auto magnitude = [](float ar, float ai, float br, float bi, int k) {
+      float evenRe = (ar + br) * 0.5f;
+      float evenIm = (ai - bi) * 0.5f;
+      float oddRe = (ai + bi) * 0.5f;
+      float oddIm = (br - ar) * 0.5f;
+      float re = evenRe + twiddles.cos[k] * oddRe + twiddles.sin[k] * oddIm;
+      float im = evenIm + twiddles.cos[k] * oddIm - twiddles.sin[k] * oddRe;
+      return sqrtf(re * re + im * im);
+    };
+    for (int k = 0; k <= points / 2; k++) {
+      int pair = (points - k) % points;
+      float ar = z[2 * k];
+      float ai = z[2 * k + 1];
+      float br = z[2 * pair];
+      float bi = z[2 * pair + 1];
+      onBin(k, magnitude(ar, ai, br, bi, k));
+      if (pair != k && pair != 0) {
+        onBin(pair, magnitude(br, bi, ar, ai, pair));
+      }
+    }
+  }
+
+  // Fixed point version of the above, scale being the value returned by Detrend(). Each stage is scaled
+  // down when its butterflies could overflow, and the magnitudes are converted back to ADC counts.
+  template <typename OnBin>
+  void MagnitudeSpectrum(std::array<int16_t, dataLength>& data, int scale, OnBin&& onBin) {
+    constexpr int points = spectrumLength;
+    int16_t* z = data.data();
+    BitReversal(z, points);
+
+    int exponent = 0;
+    for (int size = 2; size <= points; size <<= 1) {
+      // A butterfly output is at most (1 + sqrt(2)) times the largest input value
+      int32_t max = 0;
+      for (auto value : data) {
+        max = std::max(max, std::abs(static_cast<int32_t>(value)));
+      }
+      int stageShift = 0;
+      while (((max * 5) >> (1 + stageShift)) > INT16_MAX) {
+        stageShift++;
+      }
+      exponent += stageShift;
+
+      int half = size >> 1;
+      int step = dataLength / size;
+      for (int start = 0; start < points; start += size) {
+        for (int k = 0; k < half; k++) {
+          int32_t wr = fixedTwiddles.cos[k * step];
+          int32_t wi = -fixedTwiddles.sin[k * step];
+          int a = 2 * (start + k);
+          int b = 2 * (start + k + half);
+          int32_t tr = Multiply(z[b], wr) - Multiply(z[b + 1], wi);
+          int32_t ti = Multiply(z[b], wi) + Multiply(z[b + 1], wr);
+          int32_t ar = z[a];
+          int32_t ai = z[a + 1];
+          z[b] = static_cast<int16_t>((ar - tr) >> stageShift);
+          z[b + 1] = static_cast<int16_t>((ai - ti) >> stageShift);
+          z[a] = static_cast<int16_t>((ar + tr) >> stageShift);
+          z[a + 1] = static_cast<int16_t>((ai + ti) >> stageShift);
+        }
+      }
+    }
+
+    // Computed on twice the values to avoid the divisions by 2, hence the extra 1 in outputShift
+    int outputShift = FixedTraits::magnitudeFractionBits + exponent - scale - 1;
+    int64_t numeratorShift = std::max(outputShift, 0);
+    int64_t denominator = static_cast<int64_t>(dataLength - 1) << std::max(-outputShift, 0);
+    auto magnitude = [numeratorShift, denominator](int32_t ar, int32_t ai, int32_t br, int32_t bi, int k) {
+      int32_t evenRe = ar + br;
+      int32_t evenIm = ai - bi;
+      int32_t oddRe = ai + bi;
+      int32_t oddIm = br - ar;
+      int64_t wr = fixedTwiddles.cos[k];
+      int64_t wi = fixedTwiddles.sin[k];
+      int64_t re = evenRe + ((wr * oddRe + wi * oddIm) >> FixedTraits::factorFractionBits);
+      int64_t im = evenIm + ((wr * oddIm - wi * oddRe) >> FixedTraits::factorFractionBits);
+      int64_t numerator = static_cast<int64_t>(SquareRoot(static_cast<uint64_t>(re * re + im * im))) << numeratorShift;
+      return static_cast<int32_t>((numerator + denominator / 2) / denominator);
+    };
+    for (int k = 0; k <= points / 2; k++) {
+      int pair = (points - k) % points;
+      int32_t ar = z[2 * k];
+      int32_t ai = z[2 * k + 1];
+      int32_t br = z[2 * pair];
+      int32_t bi = z[2 * pair + 1];
+      onBin(k, magnitude(ar, ai, br, bi, k));
+      if (pair != k && pair != 0) {
+        onBin(pair, magnitude(br, bi, ar, ai, pair));
+      }
+    }
+  }
 }
 
-Ppg::Ppg() {
-  dataAverage.fill(0.0f);
-  spectrum.fill(0.0f);
+template <typename Sample>
+BasicPpg<Sample>::BasicPpg() {
+  dataAverage.fill(0);
+  spectrum.fill(0);
 }
 
-int8_t Ppg::Preprocess(uint32_t hrs, uint32_t als) {
-  if (dataIndex < dataLength) {
-    dataHRS[dataIndex++] = hrs;
+template <typename Sample>
+int8_t BasicPpg<Sample>::Preprocess(uint32_t hrs, uint32_t als) {
+  if (dataCount < dataLength) {
+    dataHRS[(dataHead + dataCount) & (dataLength - 1)] = hrs;
+    dataCount++;
   }
   alsValue = als;
   if (alsValue > alsThreshold) {
@@ -153,89 +483,71 @@ int8_t Ppg::Preprocess(uint32_t hrs, uint32_t als) {
   return 0;
 }
 
-int Ppg::HeartRate() {
-  if (dataIndex < dataLength) {
+template <typename Sample>
+int BasicPpg<Sample>::HeartRate() {
+  if (dataCount < dataLength) {
     return 0;
   }
   int hr = 0;
   hr = ProcessHeartRate(resetSpectralAvg);
   resetSpectralAvg = false;
-  // Make room for overlapWindow number of new samples
-  for (int idx = 0; idx < dataLength - overlapWindow; idx++) {
-    dataHRS[idx] = dataHRS[idx + overlapWindow];
-  }
-  dataIndex = dataLength - overlapWindow;
+  // Drop the overlapWindow oldest samples to make room for the new ones
+  dataHead = (dataHead + overlapWindow) & (dataLength - 1);
+  dataCount = dataLength - overlapWindow;
   return hr;
 }
 
-void Ppg::Reset(bool resetDaqBuffer) {
+template <typename Sample>
+void BasicPpg<Sample>::Reset(bool resetDaqBuffer) {
   if (resetDaqBuffer) {
-    dataIndex = 0;
+    dataHead = 0;
+    dataCount = 0;
   }
   avgIndex = 0;
-  dataAverage.fill(0.0f);
-  lastPeakLocation = 0.0f;
+  dataAverage.fill(0);
+  lastPeakLocation = 0;
   alsThreshold = UINT16_MAX;
   alsValue = 0;
   resetSpectralAvg = true;
-  spectrum.fill(0.0f);
+  spectrum.fill(0);
 }
 
 // Pass init == true to reset spectral averaging.
 // Returns -1 (Reset Acquisition), 0 (Unable to obtain HR) or HR (BPM).
-int Ppg::ProcessHeartRate(bool init) {
-  std::copy(dataHRS.begin(), dataHRS.end(), vReal.begin());
-  Detrend(vReal);
+template <typename Sample>
+int BasicPpg<Sample>::ProcessHeartRate(bool init) {
+  int scale = Detrend(dataHRS, dataHead, vReal);
   Filter30to240(vReal);
-  vImag.fill(0.0f);
-  // Apply Hanning Window
-  int hannIdx = 0;
-  for (int idx = 0; idx < dataLength; idx++) {
-    if (idx >= dataLength >> 1) {
-      hannIdx--;
-    }
-    vReal[idx] *= hanning[hannIdx];
-    if (idx < dataLength >> 1) {
-      hannIdx++;
-    }
+  HanningWindow(vReal);
+  // Compute the magnitude spectrum and average it with the previous ones
+  if (init) {
+    spectralAvgCount = 0;
   }
-  // Compute in place power spectrum
-  ArduinoFFT<float> FFT = ArduinoFFT<float>(vReal.data(), vImag.data(), dataLength, sampleFreq);
-  FFT.compute(FFTDirection::Forward);
-  FFT.complexToMagnitude();
-  FFT.~ArduinoFFT();
-  SpectrumAverage(vReal.data(), spectrum.data(), spectrum.size(), init);
-  peakLocation = 0.0f;
-  float threshold = peakDetectionThreshold;
-  float peakWidth = 0.0f;
+  MagnitudeSpectrum(vReal, scale, [this](int bin, Magnitude magnitude) {
+    spectrum[bin] = SpectrumAverage(spectrum[bin], magnitude);
+  });
+  if (spectralAvgCount < spectralAvgMax) {
+    spectralAvgCount++;
+  }
+  peakLocation = 0;
+  Bins peakWidth = 0;
   int specLen = spectrum.size();
-  float max = SpectrumMax(spectrum, hrROIbegin, hrROIend);
-  float signalToNoiseRatio = SignalToNoise(spectrum, hrROIbegin, hrROIend, max);
-  if (signalToNoiseRatio > signalToNoiseThreshold && spectrum.at(0) < dcThreshold) {
-    threshold *= max;
-    // Reuse VImag for interpolation x values passed to PeakSearch
-    for (int idx = 0; idx < dataLength; idx++) {
-      vImag[idx] = idx;
-    }
-    peakLocation = PeakSearch(vImag.data(),
-                              spectrum.data(),
-                              threshold,
-                              peakWidth,
-                              static_cast<float>(hrROIbegin),
-                              static_cast<float>(hrROIend),
-                              specLen);
-    peakLocation *= freqResolution;
+  Magnitude max = SpectrumMax(spectrum, hrROIbegin, hrROIend);
+  if (AboveNoiseLevel(spectrum, hrROIbegin, hrROIend, max, signalToNoiseThreshold) && spectrum.at(0) < dcThreshold) {
+    Magnitude threshold = Traits::Scale(max, peakDetectionThreshold);
+    Bins peakCenter = PeakSearch(spectrum.data(), threshold, peakWidth, hrROIbegin, hrROIend, specLen);
+    peakLocation = Traits::BinsToFrequency(peakCenter, binFrequency);
   }
   // Peak too wide? (broad spectrum noise or large, rapid HR change)
   if (peakWidth > maxPeakWidth) {
-    peakLocation = 0.0f;
+    peakLocation = 0;
   }
   // Check HR limits
   if (peakLocation < minHR || peakLocation > maxHR) {
-    peakLocation = 0.0f;
+    peakLocation = 0;
   }
   // Reset spectral averaging if bad reading
-  if (peakLocation == 0.0f) {
+  if (peakLocation == 0) {
     resetSpectralAvg = true;
   }
   // Set the ambient light threshold and return HR in BPM
@@ -243,50 +555,42 @@ int Ppg::ProcessHeartRate(bool init) {
   // Get current average HR. If HR reduced to zero, return -1 (reset) else HR
   peakLocation = HeartRateAverage(peakLocation);
   int rtn = -1;
-  if (peakLocation == 0.0f && lastPeakLocation > 0.0f) {
-    lastPeakLocation = 0.0f;
+  if (peakLocation == 0 && lastPeakLocation > 0) {
+    lastPeakLocation = 0;
   } else {
     lastPeakLocation = peakLocation;
-    rtn = static_cast<int>((peakLocation * 60.0f) + 0.5f);
+    rtn = Traits::ToBpm(peakLocation);
   }
   return rtn;
 }
 
-void Ppg::SpectrumAverage(const float* data, float* spectrum, int length, bool reset) {
-  if (reset) {
-    spectralAvgCount = 0;
-  }
-  float count = static_cast<float>(spectralAvgCount);
-  for (int idx = 0; idx < length; idx++) {
-    spectrum[idx] = (spectrum[idx] * count + data[idx]) / (count + 1);
-  }
-  if (spectralAvgCount < spectralAvgMax) {
-    spectralAvgCount++;
-  }
+template <typename Sample>
+typename BasicPpg<Sample>::Magnitude BasicPpg<Sample>::SpectrumAverage(Magnitude average, Magnitude value) const {
+  Magnitude count = spectralAvgCount;
+  return (average * count + value) / (count + 1);
 }
 
-float Ppg::HeartRateAverage(float hr) {
+template <typename Sample>
+typename BasicPpg<Sample>::Frequency BasicPpg<Sample>::HeartRateAverage(Frequency hr) {
   avgIndex++;
   avgIndex %= dataAverage.size();
   dataAverage[avgIndex] = hr;
-  float avg = 0.0f;
-  float total = 0.0f;
-  float min = 300.0f;
-  float max = 0.0f;
-  for (const float& value : dataAverage) {
-    if (value > 0.0f) {
+  // Sum of the values, float or an integer wide enough for the fixed point frequencies
+  decltype(Frequency {} + Frequency {}) avg = 0;
+  decltype(avg) total = 0;
+  for (const Frequency& value : dataAverage) {
+    if (value > 0) {
       avg += value;
-      if (value < min)
-        min = value;
-      if (value > max)
-        max = value;
       total++;
     }
   }
   if (total > 0) {
     avg /= total;
   } else {
-    avg = 0.0f;
+    avg = 0;
   }
-  return avg;
+  return static_cast<Frequency>(avg);
 }
+
+template class Pinetime::Controllers::BasicPpg<float>;
+template class Pinetime::Controllers::BasicPpg<int16_t>;
@@ -3,17 +3,114 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
-// Note: Change internal define 'sqrt_internal sqrt' to
-// 'sqrt_internal sqrtf' to save ~3KB of flash.
-#define sqrt_internal sqrtf
-#define FFT_SPEED_OVER_PRECISION
-#include "libs/arduinoFFT/src/arduinoFFT.h"
 
 namespace Pinetime {
   namespace Controllers {
-    class Ppg {
+    // Types and units used by the signal chain for a given sample type.
+    template <typename Sample>
+    struct PpgTraits;
+
+    // Floating point signal chain (reference implementation).
+    template <>
+    struct PpgTraits<float> {
+      // Spectrum magnitude
+      using Magnitude = float;
+      // Frequency in Hz
+      using Frequency = float;
+      // Position in the spectrum (bins)
+      using Bins = float;
+      // Factor applied to a magnitude
+      using Factor = float;
+
+      static constexpr Magnitude ToMagnitude(float value) {
+        return value;
+      }
+
+      static constexpr Frequency ToFrequency(float hz) {
+        return hz;
+      }
+
+      static constexpr Bins ToBins(float bins) {
+        return bins;
+      }
+
+      static constexpr Factor ToFactor(float factor) {
+        return factor;
+      }
+
+      static constexpr Factor ToBinFrequency(float resolution) {
+        return resolution;
+      }
+
+      static Magnitude Scale(Magnitude value, Factor factor) {
+        return value * factor;
+      }
+
+      static Frequency BinsToFrequency(Bins bins, Factor binFrequency) {
+        return bins * binFrequency;
+      }
+
+      static int ToBpm(Frequency hz) {
+        return static_cast<int>((hz * 60.0f) + 0.5f);
+      }
+    };
+
+    // Fixed point signal chain, so that the heart rate task never uses the FPU. The signal is stored in Q15,
+    // scaled for each window to use most of the range, and the spectrum in ADC counts.
+    template <>
+    struct PpgTraits<int16_t> {
+      static constexpr int magnitudeFractionBits = 6;
+      static constexpr int binsFractionBits = 8;
+      static constexpr int frequencyFractionBits = 12;
+      static constexpr int factorFractionBits = 15;
+
+      // Spectrum magnitude, in ADC counts with magnitudeFractionBits fractional bits
+      using Magnitude = int32_t;
+      // Frequency in Hz with frequencyFractionBits fractional bits
+      using Frequency = uint16_t;
+      // Position in the spectrum with binsFractionBits fractional bits
+      using Bins = int32_t;
+      // Factor with factorFractionBits fractional bits
+      using Factor = int32_t;
+
+      static constexpr Magnitude ToMagnitude(float value) {
+        return static_cast<Magnitude>(value * (1 << magnitudeFractionBits) + 0.5f);
+      }
+
+      static constexpr Frequency ToFrequency(float hz) {
+        return static_cast<Frequency>(hz * (1 << frequencyFractionBits) + 0.5f);
+      }
+
+      static constexpr Bins ToBins(float bins) {
+        return static_cast<Bins>(bins * (1 << binsFractionBits) + 0.5f);
+      }
+
+      static constexpr Factor ToFactor(float factor) {
+        return static_cast<Factor>(factor * (1 << factorFractionBits) + (factor < 0.0f ? -0.5f : 0.5f));
+      }
+
+      // Factor converting bins into a frequency, given the frequency resolution (Hz)
+      static constexpr Factor ToBinFrequency(float resolution) {
+        return ToFactor(resolution * (1 << (frequencyFractionBits - binsFractionBits)));
+      }
+
+      static Magnitude Scale(Magnitude value, Factor factor) {
+        return static_cast<Magnitude>((static_cast<int64_t>(value) * factor) >> factorFractionBits);
+      }
+
+      static Frequency BinsToFrequency(Bins bins, Factor binFrequency) {
+        return static_cast<Frequency>((static_cast<int64_t>(bins) * binFrequency) >> factorFractionBits);
+      }
+
+      static int ToBpm(Frequency hz) {
+        return (hz * 60 + (1 << (frequencyFractionBits - 1))) >> frequencyFractionBits;
+      }
+    };
+
+    template <typename Sample>
+    class BasicPpg {
     public:
-      Ppg();
+      BasicPpg();
       int8_t Preprocess(uint32_t hrs, uint32_t als);
       int HeartRate();
       void Reset(bool resetDaqBuffer);
@@ -21,12 +118,20 @@ namespace Pinetime {
       // Daq dataLength: Must be power of 2
       static constexpr uint16_t dataLength = 64;
       static constexpr uint16_t spectrumLength = dataLength >> 1;
+      static_assert((dataLength & (dataLength - 1)) == 0, "dataLength must be a power of 2");
 
     private:
+      using Traits = PpgTraits<Sample>;
+      using Magnitude = typename Traits::Magnitude;
+      using Frequency = typename Traits::Frequency;
+      using Bins = typename Traits::Bins;
+
       // The sampling frequency (Hz) based on sampling time in milliseconds (DeltaTms)
       static constexpr float sampleFreq = 1000.0f / static_cast<float>(deltaTms);
       // The frequency resolution (Hz)
       static constexpr float freqResolution = sampleFreq / dataLength;
+      // Converts a position in the spectrum into a frequency
+      static constexpr auto binFrequency = Traits::ToBinFrequency(freqResolution);
       // Number of samples before each analysis
       // 0.5 second update rate at 10Hz
       static constexpr uint16_t overlapWindow = 5;
@@ -34,47 +139,52 @@ namespace Pinetime {
       // Note: actual number of spectra averaged = spectralAvgMax + 1
       static constexpr uint16_t spectralAvgMax = 2;
       // Multiple Peaks above this threshold (% of max) are rejected
-      static constexpr float peakDetectionThreshold = 0.6f;
+      static constexpr auto peakDetectionThreshold = Traits::ToFactor(0.6f);
       // Maximum peak width (bins) at threshold for valid peak.
-      static constexpr float maxPeakWidth = 2.5f;
+      static constexpr Bins maxPeakWidth = Traits::ToBins(2.5f);
       // Metric for spectrum noise level.
-      static constexpr float signalToNoiseThreshold = 3.0f;
+      static constexpr auto signalToNoiseThreshold = Traits::ToFactor(3.0f);
       // Heart rate Region Of Interest begin (bins)
       static constexpr uint16_t hrROIbegin = static_cast<uint16_t>((30.0f / 60.0f) / freqResolution + 0.5f);
       // Heart rate Region Of Interest end (bins)
       static constexpr uint16_t hrROIend = static_cast<uint16_t>((240.0f / 60.0f) / freqResolution + 0.5f);
       // Minimum HR (Hz)
-      static constexpr float minHR = 40.0f / 60.0f;
+      static constexpr Frequency minHR = Traits::ToFrequency(40.0f / 60.0f);
       // Maximum HR (Hz)
-      static constexpr float maxHR = 230.0f / 60.0f;
+      static constexpr Frequency maxHR = Traits::ToFrequency(230.0f / 60.0f);
       // Threshold for high DC level after filtering
-      static constexpr float dcThreshold = 0.5f;
+      static constexpr Magnitude dcThreshold = Traits::ToMagnitude(0.5f);
       // ALS detection factor
-      static constexpr float alsFactor = 2.0f;
+      static constexpr uint16_t alsFactor = 2;
 
-      // Raw ADC data
+      // Raw ADC data, stored as a ring buffer starting at dataHead
       std::array<uint16_t, dataLength> dataHRS;
-      // Stores Real numbers from FFT
-      std::array<float, dataLength> vReal;
-      // Stores Imaginary numbers from FFT
-      std::array<float, dataLength> vImag;
-      // Stores power spectrum calculated from FFT real and imag values
-      std::array<float, (spectrumLength)> spectrum;
+      // Filtered signal, FFT input
+      std::array<Sample, dataLength> vReal;
+      // Stores the average of the magnitude spectra calculated by the FFT
+      std::array<Magnitude, spectrumLength> spectrum;
       // Stores each new HR value (Hz). Non zero values are averaged for HR output
-      std::array<float, 20> dataAverage;
+      std::array<Frequency, 20> dataAverage;
 
       uint16_t avgIndex = 0;
       uint16_t spectralAvgCount = 0;
-      float lastPeakLocation = 0.0f;
+      Frequency lastPeakLocation = 0;
       uint16_t alsThreshold = UINT16_MAX;
       uint16_t alsValue = 0;
-      uint16_t dataIndex = 0;
-      float peakLocation;
+      uint16_t dataHead = 0;
+      uint16_t dataCount = 0;
+      Frequency peakLocation;
       bool resetSpectralAvg = true;
 
       int ProcessHeartRate(bool init);
-      float HeartRateAverage(float hr);
-      void SpectrumAverage(const float* data, float* spectrum, int length, bool reset);
+      Frequency HeartRateAverage(Frequency hr);
+      Magnitude SpectrumAverage(Magnitude average, Magnitude value) const;
     };
+
+#ifdef PPG_FIXED_POINT
+    using Ppg = BasicPpg<int16_t>;
+#else
+    using Ppg = BasicPpg<float>;
+#endif
   }
 }
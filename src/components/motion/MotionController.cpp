@@ -1,6 +1,6 @@
 #include "components/motion/MotionController.h"
 
-#include <task.h>
+#include <cstdlib>
 
 #include "utility/Math.h"
 
@@ -36,17 +36,39 @@ namespace {
 }
 
 void MotionController::Update(int16_t x, int16_t y, int16_t z, uint32_t nbSteps) {
-  if (this->nbSteps != nbSteps && service != nullptr) {
-    service->OnNewStepCountValue(nbSteps);
-  }
-
   if (service != nullptr && (this->x != x || yHistory[0] != y || zHistory[0] != z)) {
     service->OnNewMotionValues(x, y, z);
   }
 
-  lastTime = time;
-  time = xTaskGetTickCount();
+  AddHistoryEntry(x, y, z);
+  UpdateSteps(nbSteps);
+}
+
+void MotionController::Update(const Pinetime::Drivers::Bma421::Sample* samples, size_t nbSamples, uint32_t nbSteps) {
+  if (nbSamples > 0 && service != nullptr) {
+    const auto& last = samples[nbSamples - 1];
+    service->OnNewMotionValues(last.x, last.y, last.z);
+  }
 
+  // The samples are not averaged over the whole batch: its duration depends on the FIFO level at the time it is read,
+  // and a shake would be smoothed out.
+  for (size_t i = 0; i < nbSamples; i++) {
+    sumX += samples[i].x;
+    sumY += samples[i].y;
+    sumZ += samples[i].z;
+    if (++nbSummedSamples == samplesPerEntry) {
+      AddHistoryEntry(sumX / samplesPerEntry, sumY / samplesPerEntry, sumZ / samplesPerEntry);
+      sumX = 0;
+      sumY = 0;
+      sumZ = 0;
+      nbSummedSamples = 0;
+    }
+  }
+
+  UpdateSteps(nbSteps);
+}
+
+void MotionController::AddHistoryEntry(int16_t x, int16_t y, int16_t z) {
   lastX = this->x;
   this->x = x;
   yHistory++;
@@ -56,6 +78,21 @@ void MotionController::Update(int16_t x, int16_t y, int16_t z, uint32_t nbSteps)
 
   stats = GetAccelStats();
 
+  // The shake speed is updated for each entry, so that a peak between two calls to ShouldShakeWake() is not missed
+  int32_t speed =
+    std::abs(zHistory[0] - zHistory[histSize - 1] + (yHistory[0] - yHistory[histSize - 1]) / 2 + (x - lastX) / 4) * 100 / entryPeriod;
+  // (.2 * speed) + ((1 - .2) * accumulatedSpeed);
+  accumulatedSpeed = speed / 5 + accumulatedSpeed * 4 / 5;
+  if (accumulatedSpeed > maxAccumulatedSpeed) {
+    maxAccumulatedSpeed = accumulatedSpeed;
+  }
+}
+
+void MotionController::UpdateSteps(uint32_t nbSteps) {
+  if (this->nbSteps != nbSteps && service != nullptr) {
+    service->OnNewStepCountValue(nbSteps);
+  }
+
   int32_t deltaSteps = nbSteps - this->nbSteps;
   if (deltaSteps > 0) {
     currentTripSteps += deltaSteps;
@@ -106,13 +143,9 @@ bool MotionController::ShouldRaiseWake() const {
 }
 
 bool MotionController::ShouldShakeWake(uint16_t thresh) {
-  /* Currently Polling at 10hz, If this ever goes faster scalar and EMA might need adjusting */
-  int32_t speed =
-    std::abs(zHistory[0] - zHistory[histSize - 1] + (yHistory[0] - yHistory[histSize - 1]) / 2 + (x - lastX) / 4) * 100 / (time - lastTime);
-  // (.2 * speed) + ((1 - .2) * accumulatedSpeed);
-  accumulatedSpeed = speed / 5 + accumulatedSpeed * 4 / 5;
-
-  return accumulatedSpeed > thresh;
+  const bool shaken = maxAccumulatedSpeed > thresh;
+  maxAccumulatedSpeed = accumulatedSpeed;
+  return shaken;
 }
 
 bool MotionController::ShouldLowerSleep() const {
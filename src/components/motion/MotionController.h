@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #include <FreeRTOS.h>
@@ -19,6 +20,9 @@ namespace Pinetime {
       };
 
       void Update(int16_t x, int16_t y, int16_t z, uint32_t nbSteps);
+      // Updates the controller with the samples buffered by the sensor since the previous update (oldest first).
+      // The motion detection runs at 10Hz: each group of samplesPerEntry samples is averaged into a history entry.
+      void Update(const Pinetime::Drivers::Bma421::Sample* samples, size_t nbSamples, uint32_t nbSteps);
 
       int16_t X() const {
         return x;
@@ -44,6 +48,7 @@ namespace Pinetime {
         return currentTripSteps;
       }
 
+      // True if the shake speed exceeded thresh since the previous call
       bool ShouldShakeWake(uint16_t thresh);
       bool ShouldRaiseWake() const;
       bool ShouldLowerSleep() const;
@@ -66,9 +71,6 @@ namespace Pinetime {
       uint32_t nbSteps = 0;
       uint32_t currentTripSteps = 0;
 
-      TickType_t lastTime = 0;
-      TickType_t time = 0;
-
       struct AccelStats {
         static constexpr uint8_t numHistory = 2;
 
@@ -82,6 +84,8 @@ namespace Pinetime {
       };
 
       AccelStats GetAccelStats() const;
+      void UpdateSteps(uint32_t nbSteps);
+      void AddHistoryEntry(int16_t x, int16_t y, int16_t z);
 
       AccelStats stats = {};
 
@@ -91,6 +95,15 @@ namespace Pinetime {
       Utility::CircularBuffer<int16_t, histSize> yHistory = {};
       Utility::CircularBuffer<int16_t, histSize> zHistory = {};
       int32_t accumulatedSpeed = 0;
+      int32_t maxAccumulatedSpeed = 0;
+
+      // 100Hz output data rate of the sensor
+      static constexpr uint8_t samplesPerEntry = 10;
+      static constexpr TickType_t entryPeriod = pdMS_TO_TICKS(100);
+      int32_t sumX = 0;
+      int32_t sumY = 0;
+      int32_t sumZ = 0;
+      uint8_t nbSummedSamples = 0;
 
       DeviceTypes deviceType = DeviceTypes::Unknown;
       Pinetime::Controllers::MotionService* service = nullptr;
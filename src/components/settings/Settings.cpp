@@ -1,9 +1,37 @@
 #include "components/settings/Settings.h"
+#include <cstddef>
 #include <cstdlib>
 #include <cstring>
 
 using namespace Pinetime::Controllers;
 
+namespace {
+  // Settings are stored as a log of records, one for each changed value, so that a change only appends a few bytes
+  constexpr const char* settingsFileName = "/settings.log";
+  constexpr const char* compactedFileName = "/settings.tmp";
+  constexpr const char* legacySettingsFileName = "/settings.dat";
+}
+
+const std::array<Settings::Field, 17> Settings::fields {{
+  {Keys::StepsGoal, offsetof(SettingsData, stepsGoal), sizeof(SettingsData::stepsGoal)},
+  {Keys::ScreenTimeOut, offsetof(SettingsData, screenTimeOut), sizeof(SettingsData::screenTimeOut)},
+  {Keys::ClockType, offsetof(SettingsData, clockType), sizeof(SettingsData::clockType)},
+  {Keys::WeatherFormat, offsetof(SettingsData, weatherFormat), sizeof(SettingsData::weatherFormat)},
+  {Keys::NotificationStatus, offsetof(SettingsData, notificationStatus), sizeof(SettingsData::notificationStatus)},
+  {Keys::WatchFace, offsetof(SettingsData, watchFace), sizeof(SettingsData::watchFace)},
+  {Keys::ChimesOption, offsetof(SettingsData, chimesOption), sizeof(SettingsData::chimesOption)},
+  {Keys::PTSColorTime, offsetof(SettingsData, PTS.ColorTime), sizeof(PineTimeStyle::ColorTime)},
+  {Keys::PTSColorBar, offsetof(SettingsData, PTS.ColorBar), sizeof(PineTimeStyle::ColorBar)},
+  {Keys::PTSColorBG, offsetof(SettingsData, PTS.ColorBG), sizeof(PineTimeStyle::ColorBG)},
+  {Keys::PTSGaugeStyle, offsetof(SettingsData, PTS.gaugeStyle), sizeof(PineTimeStyle::gaugeStyle)},
+  {Keys::PTSWeather, offsetof(SettingsData, PTS.weatherEnable), sizeof(PineTimeStyle::weatherEnable)},
+  {Keys::InfineatShowSideCover, offsetof(SettingsData, watchFaceInfineat.showSideCover), sizeof(WatchFaceInfineat::showSideCover)},
+  {Keys::InfineatColorIndex, offsetof(SettingsData, watchFaceInfineat.colorIndex), sizeof(WatchFaceInfineat::colorIndex)},
+  {Keys::WakeUpMode, offsetof(SettingsData, wakeUpMode), sizeof(SettingsData::wakeUpMode)},
+  {Keys::ShakeWakeThreshold, offsetof(SettingsData, shakeWakeThreshold), sizeof(SettingsData::shakeWakeThreshold)},
+  {Keys::BrightLevel, offsetof(SettingsData, brightLevel), sizeof(SettingsData::brightLevel)},
+}};
+
 Settings::Settings(Pinetime::Controllers::FS& fs) : fs {fs} {
 }
 
@@ -23,25 +51,104 @@ void Settings::SaveSettings() {
 }
 
 void Settings::LoadSettingsFromFile() {
-  SettingsData bufferSettings;
   lfs_file_t settingsFile;
 
-  if (fs.FileOpen(&settingsFile, "/settings.dat", LFS_O_RDONLY) != LFS_ERR_OK) {
-    return;
+  if (fs.FileOpen(&settingsFile, settingsFileName, LFS_O_RDONLY) == LFS_ERR_OK) {
+    ReadRecords(settingsFile);
+    fs.FileClose(&settingsFile);
+  } else if (fs.FileOpen(&settingsFile, legacySettingsFileName, LFS_O_RDONLY) == LFS_ERR_OK) {
+    // Convert the settings saved by a previous version
+    SettingsData bufferSettings;
+    int size = fs.FileRead(&settingsFile, reinterpret_cast<uint8_t*>(&bufferSettings), sizeof(settings));
+    fs.FileClose(&settingsFile);
+    if (size == sizeof(settings) && bufferSettings.version == settingsVersion) {
+      settings = bufferSettings;
+    }
+    if (CompactSettingsFile() == LFS_ERR_OK) {
+      fs.FileDelete(legacySettingsFileName);
+    }
   }
-  fs.FileRead(&settingsFile, reinterpret_cast<uint8_t*>(&bufferSettings), sizeof(settings));
-  fs.FileClose(&settingsFile);
-  if (bufferSettings.version == settingsVersion) {
-    settings = bufferSettings;
+  savedSettings = settings;
+}
+
+// Applies the records of the settings file in order. Records of unknown keys are skipped, as well as
+// records whose size doesn't match the current field, so that these settings keep their default value.
+void Settings::ReadRecords(lfs_file_t& settingsFile) {
+  uint32_t position = 0;
+  uint8_t header[recordHeaderSize];
+
+  while (fs.FileRead(&settingsFile, header, recordHeaderSize) == recordHeaderSize) {
+    const Field* field = FindField(header[0]);
+    uint8_t size = header[1];
+    position += recordHeaderSize + size;
+
+    if (field != nullptr && field->size == size) {
+      if (fs.FileRead(&settingsFile, reinterpret_cast<uint8_t*>(&settings) + field->offset, size) != size) {
+        return;
+      }
+    } else if (fs.FileSeek(&settingsFile, position) < 0) {
+      return;
+    }
   }
 }
 
 void Settings::SaveSettingsToFile() {
   lfs_file_t settingsFile;
 
-  if (fs.FileOpen(&settingsFile, "/settings.dat", LFS_O_WRONLY | LFS_O_CREAT) != LFS_ERR_OK) {
+  if (fs.FileOpen(&settingsFile, settingsFileName, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND) != LFS_ERR_OK) {
     return;
   }
-  fs.FileWrite(&settingsFile, reinterpret_cast<uint8_t*>(&settings), sizeof(settings));
+  for (const auto& field : fields) {
+    if (std::memcmp(reinterpret_cast<const uint8_t*>(&settings) + field.offset,
+                    reinterpret_cast<const uint8_t*>(&savedSettings) + field.offset,
+                    field.size) != 0) {
+      WriteRecord(settingsFile, field);
+    }
+  }
+  int fileSize = fs.FileSize(&settingsFile);
   fs.FileClose(&settingsFile);
+  savedSettings = settings;
+
+  if (fileSize > maxFileSize) {
+    CompactSettingsFile();
+  }
+}
+
+// Writes the current value of all the settings into a new file, which then replaces the settings file
+int Settings::CompactSettingsFile() {
+  lfs_file_t settingsFile;
+
+  int res = fs.FileOpen(&settingsFile, compactedFileName, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+  if (res != LFS_ERR_OK) {
+    return res;
+  }
+  for (const auto& field : fields) {
+    res = WriteRecord(settingsFile, field);
+    if (res < 0) {
+      break;
+    }
+  }
+  fs.FileClose(&settingsFile);
+  if (res < 0) {
+    fs.FileDelete(compactedFileName);
+    return res;
+  }
+  return fs.Rename(compactedFileName, settingsFileName);
+}
+
+int Settings::WriteRecord(lfs_file_t& settingsFile, const Field& field) {
+  uint8_t record[recordHeaderSize + maxFieldSize];
+  record[0] = static_cast<uint8_t>(field.key);
+  record[1] = field.size;
+  std::memcpy(record + recordHeaderSize, reinterpret_cast<const uint8_t*>(&settings) + field.offset, field.size);
+  return fs.FileWrite(&settingsFile, record, recordHeaderSize + field.size);
+}
+
+const Settings::Field* Settings::FindField(uint8_t key) {
+  for (const auto& field : fields) {
+    if (static_cast<uint8_t>(field.key) == key) {
+      return &field;
+    }
+  }
+  return nullptr;
 }
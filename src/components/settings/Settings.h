@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <cstdint>
 #include <bitset>
 #include "components/brightness/BrightnessController.h"
@@ -286,6 +287,7 @@ namespace Pinetime {
     private:
       Pinetime::Controllers::FS& fs;
 
+      // Version of the SettingsData struct written as a whole to /settings.dat by previous versions
       static constexpr uint32_t settingsVersion = 0x0007;
 
       struct SettingsData {
@@ -310,7 +312,44 @@ namespace Pinetime {
         Controllers::BrightnessController::Levels brightLevel = Controllers::BrightnessController::Levels::Medium;
       };
 
+      // Identifies a setting in the settings file. Values must never be changed or reused.
+      enum class Keys : uint8_t {
+        StepsGoal = 1,
+        ScreenTimeOut = 2,
+        ClockType = 3,
+        WeatherFormat = 4,
+        NotificationStatus = 5,
+        WatchFace = 6,
+        ChimesOption = 7,
+        PTSColorTime = 8,
+        PTSColorBar = 9,
+        PTSColorBG = 10,
+        PTSGaugeStyle = 11,
+        PTSWeather = 12,
+        InfineatShowSideCover = 13,
+        InfineatColorIndex = 14,
+        WakeUpMode = 15,
+        ShakeWakeThreshold = 16,
+        BrightLevel = 17
+      };
+
+      struct Field {
+        Keys key;
+        uint8_t offset;
+        uint8_t size;
+      };
+
+      // Each record in the settings file is a key, a size and the value of a field
+      static constexpr uint8_t recordHeaderSize = 2;
+      static constexpr uint8_t maxFieldSize = 8;
+      static_assert(sizeof(SettingsData::wakeUpMode) <= maxFieldSize, "Wake up mode doesn't fit in a record");
+      // The settings file is rewritten with the current values once it grows beyond this size
+      static constexpr int maxFileSize = 1024;
+      static const std::array<Field, 17> fields;
+
       SettingsData settings;
+      // Settings as they are stored in the settings file
+      SettingsData savedSettings;
       bool settingsChanged = false;
 
       uint8_t appMenu = 0;
@@ -323,6 +362,10 @@ namespace Pinetime {
 
       void LoadSettingsFromFile();
       void SaveSettingsToFile();
+      void ReadRecords(lfs_file_t& settingsFile);
+      int CompactSettingsFile();
+      int WriteRecord(lfs_file_t& settingsFile, const Field& field);
+      static const Field* FindField(uint8_t key);
     };
   }
 }
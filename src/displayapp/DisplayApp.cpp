@@ -79,7 +79,8 @@ DisplayApp::DisplayApp(Drivers::St7789& lcd,
                        Pinetime::Controllers::AlarmController& alarmController,
                        Pinetime::Controllers::BrightnessController& brightnessController,
                        Pinetime::Controllers::TouchHandler& touchHandler,
-                       Pinetime::Controllers::FS& filesystem)
+                       Pinetime::Controllers::FS& filesystem,
+                       Pinetime::Controllers::FrameStatistics& frameStatistics)
   : lcd {lcd},
     touchPanel {touchPanel},
     batteryController {batteryController},
@@ -95,7 +96,8 @@ DisplayApp::DisplayApp(Drivers::St7789& lcd,
     brightnessController {brightnessController},
     touchHandler {touchHandler},
     filesystem {filesystem},
-    lvgl {lcd, filesystem},
+    frameStatistics {frameStatistics},
+    lvgl {lcd, filesystem, frameStatistics},
     timer(this, TimerCallback),
     controllers {batteryController,
                  bleController,
@@ -535,7 +537,9 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
                                                             bleController,
                                                             watchdog,
                                                             motionController,
-                                                            touchPanel);
+                                                            touchPanel,
+                                                            frameStatistics,
+                                                            *systemTask);
       break;
     case Apps::FlashLight:
       currentScreen = std::make_unique<Screens::FlashLight>(*systemTask, brightnessController);
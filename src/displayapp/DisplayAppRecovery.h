@@ -34,6 +34,7 @@ namespace Pinetime {
     class AlarmController;
     class BrightnessController;
     class FS;
+    class FrameStatistics;
     class SimpleWeatherService;
     class MusicService;
     class NavigationService;
@@ -60,7 +61,8 @@ namespace Pinetime {
                  Pinetime::Controllers::AlarmController& alarmController,
                  Pinetime::Controllers::BrightnessController& brightnessController,
                  Pinetime::Controllers::TouchHandler& touchHandler,
-                 Pinetime::Controllers::FS& filesystem);
+                 Pinetime::Controllers::FS& filesystem,
+                 Pinetime::Controllers::FrameStatistics& frameStatistics);
       void Start();
 
       void Start(Pinetime::System::BootErrors) {
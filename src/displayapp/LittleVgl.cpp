@@ -68,12 +68,21 @@ static void rounder(lv_disp_drv_t* disp_drv, lv_area_t* area) {
   }
 }
 
+static void refresh_task(lv_task_t* task) {
+  auto* disp = static_cast<lv_disp_t*>(task->user_data);
+  auto* lvgl = static_cast<LittleVgl*>(disp->driver.user_data);
+  lvgl->RefreshDisplay(task);
+}
+
 bool touchpad_read(lv_indev_drv_t* indev_drv, lv_indev_data_t* data) {
   auto* lvgl = static_cast<LittleVgl*>(indev_drv->user_data);
   return lvgl->GetTouchPadInfo(data);
 }
 
-LittleVgl::LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Controllers::FS& filesystem) : lcd {lcd}, filesystem {filesystem} {
+LittleVgl::LittleVgl(Pinetime::Drivers::St7789& lcd,
+                     Pinetime::Controllers::FS& filesystem,
+                     Pinetime::Controllers::FrameStatistics& frameStatistics)
+  : lcd {lcd}, filesystem {filesystem}, frameStatistics {frameStatistics} {
 }
 
 void LittleVgl::Init() {
@@ -85,8 +94,8 @@ void LittleVgl::Init() {
 }
 
 void LittleVgl::InitDisplay() {
-  lv_disp_buf_init(&disp_buf_2, buf2_1, buf2_2, LV_HOR_RES_MAX * 4); /*Initialize the display buffer*/
-  lv_disp_drv_init(&disp_drv);                                       /*Basic initialization*/
+  lv_disp_buf_init(&disp_buf_2, buf2_1, buf2_2, LV_HOR_RES_MAX * nbWriteLines); /*Initialize the display buffer*/
+  lv_disp_drv_init(&disp_drv);                                                  /*Basic initialization*/
 
   /*Set up the functions to access to your display*/
 
@@ -102,7 +111,10 @@ void LittleVgl::InitDisplay() {
   disp_drv.rounder_cb = rounder;
 
   /*Finally register the driver*/
-  lv_disp_drv_register(&disp_drv);
+  lv_disp_t* disp = lv_disp_drv_register(&disp_drv);
+
+  /*Merge the invalidated areas before each refresh*/
+  lv_task_set_cb(disp->refr_task, refresh_task);
 }
 
 void LittleVgl::InitTouchpad() {
@@ -149,12 +161,54 @@ void LittleVgl::SetFullRefresh(FullRefreshDirections direction) {
   fullRefresh = true;
 }
 
+void LittleVgl::RefreshDisplay(lv_task_t* refreshTask) {
+  auto* disp = static_cast<lv_disp_t*>(refreshTask->user_data);
+  CoalesceInvalidatedAreas(disp);
+
+  frameStatistics.StartFrame(xTaskGetTickCount());
+  _lv_disp_refr_task(refreshTask);
+  frameStatistics.EndFrame(xTaskGetTickCount());
+}
+
+void LittleVgl::CoalesceInvalidatedAreas(lv_disp_t* disp) {
+  // LVGL only joins overlapping areas, and only when their bounding box is smaller than both areas.
+  // Adjacent or close areas (ex: the hands of an analog watch face) are flushed separately, each one
+  // with its own address window. Merge them when sending the bounding box is cheaper.
+  auto size = [](const lv_area_t& area) -> uint32_t {
+    return static_cast<uint32_t>(area.x2 - area.x1 + 1) * static_cast<uint32_t>(area.y2 - area.y1 + 1);
+  };
+
+  bool merged;
+  do {
+    merged = false;
+    for (uint32_t i = 0; i < disp->inv_p; i++) {
+      if (disp->inv_area_joined[i] != 0) {
+        continue;
+      }
+      for (uint32_t j = i + 1; j < disp->inv_p; j++) {
+        if (disp->inv_area_joined[j] != 0) {
+          continue;
+        }
+        lv_area_t boundingBox;
+        _lv_area_join(&boundingBox, &disp->inv_areas[i], &disp->inv_areas[j]);
+        if (size(boundingBox) <= size(disp->inv_areas[i]) + size(disp->inv_areas[j]) + areaOverheadInPixels) {
+          lv_area_copy(&disp->inv_areas[i], &boundingBox);
+          disp->inv_area_joined[j] = 1;
+          merged = true;
+        }
+      }
+    }
+  } while (merged);
+}
+
 void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
   uint16_t y1, y2, width, height = 0;
+  const uint32_t nbTransactions = lcd.NbTransactions();
+  frameStatistics.StartFlush(xTaskGetTickCount());
 
   ulTaskNotifyTake(pdTRUE, 200);
-  // Notification is still needed (even if there is a mutex on SPI) because of the DataCommand pin
-  // which cannot be set/clear during a transfer.
+  // Wait for the previous buffer to be sent: DrawBuffer() only queues the transfer, and the
+  // DataCommand pin cannot be set/clear during a transfer.
 
   if ((scrollDirection == LittleVgl::FullRefreshDirections::Down) && (area->y2 == visibleNbLines - 1)) {
     writeOffset = ((writeOffset + totalNbLines) - visibleNbLines) % totalNbLines;
@@ -230,8 +284,13 @@ void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
     lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
   }
 
+  frameStatistics.EndFlush(xTaskGetTickCount(), lv_area_get_size(area) * sizeof(lv_color_t), lcd.NbTransactions() - nbTransactions);
+
   // IMPORTANT!!!
-  // Inform the graphics library that you are ready with the flushing
+  // Inform the graphics library that you are ready with the flushing.
+  // The transfer is still running in the background (DMA chained by PPI), but LVGL will render the next
+  // area into the other buffer. The notification at the beginning of the next flush ensures that the
+  // transfer of this buffer is done before the display window is changed and before this buffer is reused.
   lv_disp_flush_ready(&disp_drv);
 }
 
@@ -2,6 +2,7 @@
 
 #include <lvgl/lvgl.h>
 #include <components/fs/FS.h>
+#include "components/display/FrameStatistics.h"
 
 namespace Pinetime {
   namespace Drivers {
@@ -12,7 +13,9 @@ namespace Pinetime {
     class LittleVgl {
     public:
       enum class FullRefreshDirections { None, Up, Down, Left, Right, LeftAnim, RightAnim };
-      LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Controllers::FS& filesystem);
+      LittleVgl(Pinetime::Drivers::St7789& lcd,
+                Pinetime::Controllers::FS& filesystem,
+                Pinetime::Controllers::FrameStatistics& frameStatistics);
 
       LittleVgl(const LittleVgl&) = delete;
       LittleVgl& operator=(const LittleVgl&) = delete;
@@ -22,6 +25,7 @@ namespace Pinetime {
       void Init();
 
       void FlushDisplay(const lv_area_t* area, lv_color_t* color_p);
+      void RefreshDisplay(lv_task_t* refreshTask);
       bool GetTouchPadInfo(lv_indev_data_t* ptr);
       void SetFullRefresh(FullRefreshDirections direction);
       void SetNewTouchPoint(int16_t x, int16_t y, bool contact);
@@ -39,21 +43,29 @@ namespace Pinetime {
       void InitDisplay();
       void InitTouchpad();
       void InitFileSystem();
+      void CoalesceInvalidatedAreas(lv_disp_t* disp);
 
       Pinetime::Drivers::St7789& lcd;
       Pinetime::Controllers::FS& filesystem;
+      Pinetime::Controllers::FrameStatistics& frameStatistics;
 
+      static constexpr uint8_t nbWriteLines = 4;
+
+      // LVGL renders into one buffer while the other one is being sent to the display by DMA
       lv_disp_buf_t disp_buf_2;
-      lv_color_t buf2_1[LV_HOR_RES_MAX * 4];
-      lv_color_t buf2_2[LV_HOR_RES_MAX * 4];
+      lv_color_t buf2_1[LV_HOR_RES_MAX * nbWriteLines];
+      lv_color_t buf2_2[LV_HOR_RES_MAX * nbWriteLines];
 
       lv_disp_drv_t disp_drv;
 
       bool fullRefresh = false;
-      static constexpr uint8_t nbWriteLines = 4;
       static constexpr uint16_t totalNbLines = 320;
       static constexpr uint16_t visibleNbLines = 240;
 
+      // Approximate cost, in pixels, of sending one more area to the display (address window commands,
+      // DMA setup and synchronization). Areas are merged when their bounding box costs less than that.
+      static constexpr uint32_t areaOverheadInPixels = 120;
+
       static constexpr uint8_t MaxScrollOffset() {
         return LV_VER_RES_MAX - nbWriteLines;
       }
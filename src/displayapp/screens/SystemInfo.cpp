@@ -12,7 +12,9 @@
 #include "components/brightness/BrightnessController.h"
 #include "components/datetime/DateTimeController.h"
 #include "components/motion/MotionController.h"
+#include "components/display/FrameStatistics.h"
 #include "drivers/Watchdog.h"
+#include "systemtask/SystemTask.h"
 #include "displayapp/InfiniTimeTheme.h"
 
 using namespace Pinetime::Applications::Screens;
@@ -38,7 +40,9 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
                        const Pinetime::Controllers::Ble& bleController,
                        const Pinetime::Drivers::Watchdog& watchdog,
                        Pinetime::Controllers::MotionController& motionController,
-                       const Pinetime::Drivers::Cst816S& touchPanel)
+                       const Pinetime::Drivers::Cst816S& touchPanel,
+                       const Pinetime::Controllers::FrameStatistics& frameStatistics,
+                       const Pinetime::System::SystemTask& systemTask)
   : app {app},
     dateTimeController {dateTimeController},
     batteryController {batteryController},
@@ -47,6 +51,8 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
     watchdog {watchdog},
     motionController {motionController},
     touchPanel {touchPanel},
+    frameStatistics {frameStatistics},
+    systemTask {systemTask},
     screens {app,
              0,
              {[this]() -> std::unique_ptr<Screen> {
@@ -63,6 +69,9 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
               },
               [this]() -> std::unique_ptr<Screen> {
                 return CreateScreen5();
+              },
+              [this]() -> std::unique_ptr<Screen> {
+                return CreateScreen6();
               }},
              Screens::ScreenListModes::UpDown} {
 }
@@ -95,7 +104,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen1() {
                         BootloaderVersion::VersionString());
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(0, 5, label);
+  return std::make_unique<Screens::Label>(0, 6, label);
 }
 
 std::unique_ptr<Screen> SystemInfo::CreateScreen2() {
@@ -174,7 +183,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen2() {
                         touchPanel.GetFwVersion(),
                         TARGET_DEVICE_NAME);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(1, 5, label);
+  return std::make_unique<Screens::Label>(1, 6, label);
 }
 
 extern int mallocFailedCount;
@@ -195,7 +204,9 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen3() {
                         " #808080 Free# %d\n"
                         " #808080 Min free# %d\n"
                         " #808080 Alloc err# %d\n"
-                        " #808080 Ovrfl err# %d\n",
+                        " #808080 Ovrfl err# %d\n"
+                        "#808080 Wake-ups/min#\n"
+                        " #808080 Idle# %d #808080 Msg# %d",
                         bleAddr[5],
                         bleAddr[4],
                         bleAddr[3],
@@ -205,16 +216,53 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen3() {
                         xPortGetFreeHeapSize(),
                         xPortGetMinimumEverFreeHeapSize(),
                         mallocFailedCount,
-                        stackOverflowCount);
+                        stackOverflowCount,
+                        systemTask.IdleWakeUpsPerMinute(),
+                        systemTask.MessageWakeUpsPerMinute());
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(2, 5, label);
+  return std::make_unique<Screens::Label>(2, 6, label);
+}
+
+std::unique_ptr<Screen> SystemInfo::CreateScreen4() {
+  auto ToMs = [](uint32_t ticks) -> uint32_t {
+    return (ticks * 1000) / configTICK_RATE_HZ;
+  };
+  const auto renderTime = frameStatistics.RenderTime();
+  const auto flushTime = frameStatistics.FlushTime();
+  const auto bytesSent = frameStatistics.BytesSent();
+  const auto nbAreas = frameStatistics.NbAreas();
+
+  lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
+  lv_label_set_recolor(label, true);
+  lv_label_set_text_fmt(label,
+                        "#FFFF00 Display (%d)#\n"
+                        "#808080 min/avg/max#\n"
+                        "#808080 Render#\n %lu/%lu/%lu ms\n"
+                        "#808080 Flush#\n %lu/%lu/%lu ms\n"
+                        "#808080 Bytes#\n %lu/%lu/%lu\n"
+                        "#808080 Areas# %lu/%lu/%lu",
+                        static_cast<int>(frameStatistics.NbFrames()),
+                        ToMs(renderTime.min),
+                        ToMs(renderTime.avg),
+                        ToMs(renderTime.max),
+                        ToMs(flushTime.min),
+                        ToMs(flushTime.avg),
+                        ToMs(flushTime.max),
+                        bytesSent.min,
+                        bytesSent.avg,
+                        bytesSent.max,
+                        nbAreas.min,
+                        nbAreas.avg,
+                        nbAreas.max);
+  lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
+  return std::make_unique<Screens::Label>(3, 6, label);
 }
 
 bool SystemInfo::sortById(const TaskStatus_t& lhs, const TaskStatus_t& rhs) {
   return lhs.xTaskNumber < rhs.xTaskNumber;
 }
 
-std::unique_ptr<Screen> SystemInfo::CreateScreen4() {
+std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
   static constexpr uint8_t maxTaskCount = 9;
   TaskStatus_t tasksStatus[maxTaskCount];
 
@@ -268,10 +316,10 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen4() {
     }
     lv_table_set_cell_value(infoTask, i + 1, 3, buffer);
   }
-  return std::make_unique<Screens::Label>(3, 5, infoTask);
+  return std::make_unique<Screens::Label>(4, 6, infoTask);
 }
 
-std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
+std::unique_ptr<Screen> SystemInfo::CreateScreen6() {
   lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_recolor(label, true);
   lv_label_set_text_static(label,
@@ -285,5 +333,5 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
                            "#FFFF00 InfiniTime#");
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(4, 5, label);
+  return std::make_unique<Screens::Label>(5, 6, label);
 }
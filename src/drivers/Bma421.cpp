@@ -7,6 +7,8 @@
 using namespace Pinetime::Drivers;
 
 namespace {
+  constexpr uint8_t fifoFlushCommand = 0xb0;
+
   int8_t user_i2c_read(uint8_t reg_addr, uint8_t* reg_data, uint32_t length, void* intf_ptr) {
     auto bma421 = static_cast<Bma421*>(intf_ptr);
     bma421->Read(reg_addr, reg_data, length);
@@ -58,7 +60,9 @@ void Bma421::Init() {
   if (ret != BMA4_OK)
     return;
 
-  ret = bma4_set_interrupt_mode(BMA4_LATCH_MODE, &bma);
+  // The watermark interrupt follows the FIFO level: INT1 goes low when the FIFO is read below the watermark,
+  // so that the next watermark generates a new rising edge. In latched mode, INT_STATUS would have to be read.
+  ret = bma4_set_interrupt_mode(BMA4_NON_LATCH_MODE, &bma);
   if (ret != BMA4_OK)
     return;
 
@@ -83,40 +87,140 @@ void Bma421::Init() {
   if (ret != BMA4_OK)
     return;
 
+  if (!InitFifo())
+    return;
+
   isOk = true;
 }
 
+// The accelerometer data is buffered by the FIFO (headerless mode, 6 bytes per sample) so that
+// all the samples are available, and not only the last one at each call to Process().
+// The watermark interrupt is signaled on INT1 when the FIFO should be read.
+bool Bma421::InitFifo() {
+  auto ret = bma4_set_fifo_config(BMA4_FIFO_HEADER | BMA4_FIFO_TIME, BMA4_DISABLE, &bma);
+  if (ret != BMA4_OK)
+    return false;
+
+  ret = bma4_set_fifo_config(BMA4_FIFO_ACCEL, BMA4_ENABLE, &bma);
+  if (ret != BMA4_OK)
+    return false;
+
+  ret = bma4_set_fifo_wm(fifoWatermark * BMA4_FIFO_A_LENGTH, &bma);
+  if (ret != BMA4_OK)
+    return false;
+
+  struct bma4_int_pin_config pinConfig;
+  pinConfig.edge_ctrl = BMA4_EDGE_TRIGGER;
+  pinConfig.lvl = BMA4_ACTIVE_HIGH;
+  pinConfig.od = BMA4_PUSH_PULL;
+  pinConfig.output_en = BMA4_OUTPUT_ENABLE;
+  pinConfig.input_en = BMA4_INPUT_DISABLE;
+  ret = bma4_set_int_pin_config(&pinConfig, BMA4_INTR1_MAP, &bma);
+  if (ret != BMA4_OK)
+    return false;
+
+  ret = bma4_map_interrupt(BMA4_INTR1_MAP, BMA4_FIFO_WM_INT, BMA4_ENABLE, &bma);
+  return ret == BMA4_OK;
+}
+
 void Bma421::Reset() {
   uint8_t data = 0xb6;
   twiMaster.Write(deviceAddress, 0x7E, &data, 1);
 }
 
-void Bma421::Read(uint8_t registerAddress, uint8_t* buffer, size_t size) {
-  twiMaster.Read(deviceAddress, registerAddress, buffer, size);
+bool Bma421::Read(uint8_t registerAddress, uint8_t* buffer, size_t size) {
+  return twiMaster.Read(deviceAddress, registerAddress, buffer, size) == TwiMaster::ErrorCodes::NoError;
 }
 
-void Bma421::Write(uint8_t registerAddress, const uint8_t* data, size_t size) {
-  twiMaster.Write(deviceAddress, registerAddress, data, size);
+bool Bma421::Write(uint8_t registerAddress, const uint8_t* data, size_t size) {
+  return twiMaster.Write(deviceAddress, registerAddress, data, size) == TwiMaster::ErrorCodes::NoError;
 }
 
 Bma421::Values Bma421::Process() {
   if (not isOk)
     return {};
-  struct bma4_accel data;
-  bma4_read_accel_xyz(&data, &bma);
 
-  uint32_t steps = 0;
-  bma423_step_counter_output(&steps, &bma);
+  // The step counter (0x1e-0x21), the temperature (0x22) and the FIFO length (0x24-0x25) are read in a single burst.
+  // Only the registers needed by the sampled data are read.
+  uint8_t status[statusSize] = {};
+  size_t statusLength = 0;
+  if (IsSampled(Data::Motion)) {
+    statusLength = statusSize;
+  } else if (IsSampled(Data::Temperature)) {
+    statusLength = (BMA4_TEMPERATURE_ADDR - BMA4_STEP_CNT_OUT_0_ADDR) + 1;
+  } else if (IsSampled(Data::Steps)) {
+    statusLength = BMA423_STEP_CNTR_DATA_SIZE;
+  }
+  Values values = {};
+  if (statusLength > 0 && !Read(BMA4_STEP_CNT_OUT_0_ADDR, status, statusLength)) {
+    return values;
+  }
 
-  int32_t temperature;
-  bma4_get_temperature(&temperature, BMA4_DEG, &bma);
-  temperature = temperature / 1000;
+  if (IsSampled(Data::Steps)) {
+    values.steps = static_cast<uint32_t>(status[0]) | (static_cast<uint32_t>(status[1]) << 8) |
+                   (static_cast<uint32_t>(status[2]) << 16) | (static_cast<uint32_t>(status[3]) << 24);
+  }
 
-  uint8_t activity = 0;
-  bma423_activity_output(&activity, &bma);
+  if (IsSampled(Data::Temperature)) {
+    // 0 corresponds to 23°C
+    values.temperature = static_cast<int8_t>(status[BMA4_TEMPERATURE_ADDR - BMA4_STEP_CNT_OUT_0_ADDR]) + BMA4_OFFSET_TEMP;
+  }
+
+  if (IsSampled(Data::Activity) && !Read(BMA4_ACTIVITY_OUT_ADDR, &values.activity, 1)) {
+    return values;
+  }
+
+  if (IsSampled(Data::Motion)) {
+    const uint8_t* fifoLength = &status[BMA4_FIFO_LENGTH_0_ADDR - BMA4_STEP_CNT_OUT_0_ADDR];
+    if (!ReadFifo((BMA4_GET_BITS_POS_0(fifoLength[1], BMA4_FIFO_BYTE_COUNTER_MSB) << 8) | fifoLength[0], values.nbSamples)) {
+      return values;
+    }
+    values.samples = samples;
+  }
+  values.x = lastSample.x;
+  values.y = lastSample.y;
+  values.z = lastSample.z;
+  values.isOk = true;
+  return values;
+}
+
+bool Bma421::ReadFifo(uint16_t length, size_t& nbSamples) {
+  nbSamples = 0;
+  if (length > sizeof(fifoData)) {
+    // The FIFO was not read for a while (the motion is not processed while sleeping, for example):
+    // drop these outdated samples instead of catching up with them.
+    return Write(BMA4_CMD_ADDR, &fifoFlushCommand, 1);
+  }
+
+  // Only read complete samples. The whole content of the FIFO is read, so that its level drops below the watermark.
+  length -= length % BMA4_FIFO_A_LENGTH;
+  if (length == 0)
+    return true;
+
+  if (!Read(BMA4_FIFO_DATA_ADDR, fifoData, length)) {
+    return false;
+  }
+
+  // Headerless mode: each frame contains the X, Y and Z values (12 bits, left-justified in 16 bits LSB first)
+  nbSamples = length / BMA4_FIFO_A_LENGTH;
+  for (size_t i = 0; i < nbSamples; i++) {
+    const uint8_t* frame = &fifoData[i * BMA4_FIFO_A_LENGTH];
+    const auto x = static_cast<int16_t>(static_cast<int16_t>((frame[1] << 8) | frame[0]) / 0x10);
+    const auto y = static_cast<int16_t>(static_cast<int16_t>((frame[3] << 8) | frame[2]) / 0x10);
+    const auto z = static_cast<int16_t>(static_cast<int16_t>((frame[5] << 8) | frame[4]) / 0x10);
+    // X and Y axis are swapped because of the way the sensor is mounted in the PineTime
+    samples[i] = {y, x, z};
+  }
+  lastSample = samples[nbSamples - 1];
+  return true;
+}
+
+void Bma421::SetSampled(Data data, bool sampled) {
+  sampledData.set(static_cast<size_t>(data), sampled);
+}
 
-  // X and Y axis are swapped because of the way the sensor is mounted in the PineTime
-  return {steps, data.y, data.x, data.z};
+bool Bma421::IsSampled(Data data) const {
+  return sampledData.test(static_cast<size_t>(data));
 }
 
 bool Bma421::IsOk() const {
@@ -1,4 +1,5 @@
 #pragma once
+#include <bitset>
 #include <drivers/Bma421_C/bma4_defs.h>
 
 namespace Pinetime {
@@ -9,13 +10,35 @@ namespace Pinetime {
     public:
       enum class DeviceTypes : uint8_t { Unknown, BMA421, BMA425 };
 
+      struct Sample {
+        int16_t x;
+        int16_t y;
+        int16_t z;
+      };
+
+      // Data read by Process(). Only the motion and the step count are sampled by default.
+      enum class Data : uint8_t { Motion, Steps, Temperature, Activity };
+
       struct Values {
         uint32_t steps;
         int16_t x;
         int16_t y;
         int16_t z;
+        // In °C
+        int8_t temperature;
+        uint8_t activity;
+        // Samples buffered by the FIFO since the previous call to Process(), oldest first.
+        // x, y and z above are the values of the last one. Valid until the next call to Process().
+        const Sample* samples;
+        size_t nbSamples;
+        // False if a register could not be read, the other values are then not valid
+        bool isOk;
       };
 
+      // Maximum number of samples returned by Process(), i.e. 400ms of data at 100Hz. A larger backlog is flushed,
+      // so that a single call always brings the FIFO level below the watermark.
+      static constexpr size_t fifoCapacity = 40;
+
       Bma421(TwiMaster& twiMaster, uint8_t twiAddress);
       Bma421(const Bma421&) = delete;
       Bma421& operator=(const Bma421&) = delete;
@@ -29,14 +52,28 @@ namespace Pinetime {
       Values Process();
       void ResetStepCounter();
 
-      void Read(uint8_t registerAddress, uint8_t* buffer, size_t size);
-      void Write(uint8_t registerAddress, const uint8_t* data, size_t size);
+      void SetSampled(Data data, bool sampled);
+      bool IsSampled(Data data) const;
+
+      // Return false if the TWI transaction failed
+      bool Read(uint8_t registerAddress, uint8_t* buffer, size_t size);
+      bool Write(uint8_t registerAddress, const uint8_t* data, size_t size);
 
       bool IsOk() const;
       DeviceTypes DeviceType() const;
 
     private:
       void Reset();
+      bool InitFifo();
+      bool ReadFifo(uint16_t length, size_t& nbSamples);
+
+      // From the step counter to the FIFO length registers
+      static constexpr size_t statusSize = (BMA4_FIFO_LENGTH_0_ADDR + 2) - BMA4_STEP_CNT_OUT_0_ADDR;
+
+      // Number of samples in the FIFO that trigger the watermark interrupt (250ms at 100Hz). The margin up to
+      // fifoCapacity leaves 150ms to SystemTask to read the FIFO before the samples are dropped.
+      static constexpr uint16_t fifoWatermark = 25;
+      static_assert(fifoWatermark < fifoCapacity, "The FIFO must be read below the watermark");
 
       TwiMaster& twiMaster;
       uint8_t deviceAddress = 0x18;
@@ -44,6 +81,12 @@ namespace Pinetime {
       bool isOk = false;
       bool isResetOk = false;
       DeviceTypes deviceType = DeviceTypes::Unknown;
+
+      uint8_t fifoData[fifoCapacity * BMA4_FIFO_A_LENGTH];
+      Sample samples[fifoCapacity];
+      Sample lastSample = {};
+
+      std::bitset<4> sampledData {(1 << static_cast<size_t>(Data::Motion)) | (1 << static_cast<size_t>(Data::Steps))};
     };
   }
 }
\ No newline at end of file
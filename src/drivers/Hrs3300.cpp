@@ -16,6 +16,14 @@ using namespace Pinetime::Drivers;
 
 namespace {
   static constexpr uint8_t ledDriveCurrentValue = 0x2f;
+
+  uint32_t HrsValue(uint8_t m, uint8_t h, uint8_t l) {
+    return ((l & 0x30) << 12) | (m << 8) | ((h & 0x0f) << 4) | (l & 0x0f);
+  }
+
+  uint32_t AlsValue(uint8_t m, uint8_t h, uint8_t l) {
+    return ((h & 0x3f) << 11) | (m << 3) | (l & 0x07);
+  }
 }
 
 /** Driver for the HRS3300 heart rate sensor.
@@ -43,7 +51,7 @@ void Hrs3300::Init() {
 
   // HRS and ALS both in 15-bit mode results in ~50ms LED drive period
   // and presumably ~50ms ADC conversion period.
-  WriteRegister(static_cast<uint8_t>(Registers::Res), 0x77);
+  WriteRegister(static_cast<uint8_t>(Registers::Res), 0x70 | (hrsResolution - 8));
 
   // Gain set to 1x
   WriteRegister(static_cast<uint8_t>(Registers::Hgain), 0x00);
@@ -68,21 +76,34 @@ void Hrs3300::Disable() {
 }
 
 uint32_t Hrs3300::ReadHrs() {
-  auto m = ReadRegister(static_cast<uint8_t>(Registers::C0DataM));
-  auto h = ReadRegister(static_cast<uint8_t>(Registers::C0DataH));
-  auto l = ReadRegister(static_cast<uint8_t>(Registers::C0dataL));
-  return ((l & 0x30) << 12) | (m << 8) | ((h & 0x0f) << 4) | (l & 0x0f);
+  uint8_t m, h, l;
+  ReadRegisters({{twiAddress, static_cast<uint8_t>(Registers::C0DataM), &m, 1},
+                 {twiAddress, static_cast<uint8_t>(Registers::C0DataH), &h, 1},
+                 {twiAddress, static_cast<uint8_t>(Registers::C0dataL), &l, 1}});
+  return HrsValue(m, h, l);
 }
 
 uint32_t Hrs3300::ReadAls() {
-  auto m = ReadRegister(static_cast<uint8_t>(Registers::C1dataM));
-  auto h = ReadRegister(static_cast<uint8_t>(Registers::C1dataH));
-  auto l = ReadRegister(static_cast<uint8_t>(Registers::C1dataL));
-  return ((h & 0x3f) << 11) | (m << 3) | (l & 0x07);
+  uint8_t m, h, l;
+  ReadRegisters({{twiAddress, static_cast<uint8_t>(Registers::C1dataM), &m, 1},
+                 {twiAddress, static_cast<uint8_t>(Registers::C1dataH), &h, 1},
+                 {twiAddress, static_cast<uint8_t>(Registers::C1dataL), &l, 1}});
+  return AlsValue(m, h, l);
+}
+
+Hrs3300::Values Hrs3300::ReadHrsAls() {
+  uint8_t hrsM, hrsH, hrsL;
+  uint8_t alsM, alsH, alsL;
+  ReadRegisters({{twiAddress, static_cast<uint8_t>(Registers::C1dataM), &alsM, 1},
+                 {twiAddress, static_cast<uint8_t>(Registers::C0DataM), &hrsM, 1},
+                 {twiAddress, static_cast<uint8_t>(Registers::C0DataH), &hrsH, 1},
+                 {twiAddress, static_cast<uint8_t>(Registers::C1dataH), &alsH, 1},
+                 {twiAddress, static_cast<uint8_t>(Registers::C1dataL), &alsL, 1},
+                 {twiAddress, static_cast<uint8_t>(Registers::C0dataL), &hrsL, 1}});
+  return {HrsValue(hrsM, hrsH, hrsL), AlsValue(alsM, alsH, alsL)};
 }
 
 void Hrs3300::SetGain(uint8_t gain) {
-  constexpr uint8_t maxGain = 64U;
   gain = std::min(gain, maxGain);
   uint8_t hgain = 0;
   while ((1 << hgain) < gain) {
@@ -109,6 +130,12 @@ void Hrs3300::WriteRegister(uint8_t reg, uint8_t data) {
     NRF_LOG_INFO("WRITE ERROR");
 }
 
+void Hrs3300::ReadRegisters(std::initializer_list<TwiMaster::ReadTransfer> transfers) {
+  auto ret = twiMaster.Read(transfers.begin(), transfers.size());
+  if (ret != TwiMaster::ErrorCodes::NoError)
+    NRF_LOG_INFO("READ ERROR");
+}
+
 uint8_t Hrs3300::ReadRegister(uint8_t reg) {
   uint8_t value;
   auto ret = twiMaster.Read(twiAddress, reg, &value, 1);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <initializer_list>
 #include "drivers/TwiMaster.h"
 
 namespace Pinetime {
@@ -21,6 +22,18 @@ namespace Pinetime {
         Hgain = 0x17
       };
 
+      struct Values {
+        uint32_t hrs;
+        uint32_t als;
+      };
+
+      // Gain and LED drive current levels supported by SetGain() and SetDrive()
+      static constexpr uint8_t maxGain = 64;
+      static constexpr uint8_t maxDrive = 3;
+      // Resolution (bits) of the HRS conversions configured by Init()
+      static constexpr uint8_t hrsResolution = 15;
+      static constexpr uint32_t maxHrsValue = (1 << hrsResolution) - 1;
+
       Hrs3300(TwiMaster& twiMaster, uint8_t twiAddress);
       Hrs3300(const Hrs3300&) = delete;
       Hrs3300& operator=(const Hrs3300&) = delete;
@@ -32,6 +45,8 @@ namespace Pinetime {
       void Disable();
       uint32_t ReadHrs();
       uint32_t ReadAls();
+      // Reads the HRS and ALS data registers in a single TWI batch
+      Values ReadHrsAls();
       void SetGain(uint8_t gain);
       void SetDrive(uint8_t drive);
 
@@ -41,6 +56,8 @@ namespace Pinetime {
 
       void WriteRegister(uint8_t reg, uint8_t data);
       uint8_t ReadRegister(uint8_t reg);
+      // Reads the registers in a single TWI batch
+      void ReadRegisters(std::initializer_list<TwiMaster::ReadTransfer> transfers);
     };
   }
 }
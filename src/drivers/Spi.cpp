@@ -4,17 +4,42 @@
 
 using namespace Pinetime::Drivers;
 
-Spi::Spi(SpiMaster& spiMaster, uint8_t pinCsn) : spiMaster {spiMaster}, pinCsn {pinCsn} {
+Spi::Spi(SpiMaster& spiMaster, uint8_t pinCsn, SpiMaster::Priority priority) : spiMaster {spiMaster}, pinCsn {pinCsn}, priority {priority} {
   nrf_gpio_cfg_output(pinCsn);
   nrf_gpio_pin_set(pinCsn);
 }
 
 bool Spi::Write(const uint8_t* data, size_t size) {
-  return spiMaster.Write(pinCsn, data, size);
+  if (data == nullptr)
+    return false;
+  auto& job = AcquireJob();
+  job.txData = data;
+  job.dataSize = size;
+  spiMaster.Submit(job);
+  WaitJobDone();
+  return true;
+}
+
+bool Spi::WriteAsync(const uint8_t* data, size_t size) {
+  if (data == nullptr)
+    return false;
+  auto& job = AcquireJob();
+  job.txData = data;
+  job.dataSize = size;
+  job.taskToNotify = xTaskGetCurrentTaskHandle();
+  spiMaster.Submit(job);
+  return true;
 }
 
 bool Spi::Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
-  return spiMaster.Read(pinCsn, cmd, cmdSize, data, dataSize);
+  auto& job = AcquireJob();
+  job.command = cmd;
+  job.commandSize = cmdSize;
+  job.rxData = data;
+  job.dataSize = dataSize;
+  spiMaster.Submit(job);
+  WaitJobDone();
+  return true;
 }
 
 void Spi::Sleep() {
@@ -23,10 +48,49 @@ void Spi::Sleep() {
 }
 
 bool Spi::WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize) {
-  return spiMaster.WriteCmdAndBuffer(pinCsn, cmd, cmdSize, data, dataSize);
+  auto& job = AcquireJob();
+  job.command = cmd;
+  job.commandSize = cmdSize;
+  job.txData = data;
+  job.dataSize = dataSize;
+  spiMaster.Submit(job);
+  WaitJobDone();
+  return true;
+}
+
+bool Spi::WriteCommands(uint8_t pinDataCommand, const uint8_t* commands, size_t size) {
+  if (commands == nullptr)
+    return false;
+  auto& job = AcquireJob();
+  job.pinDataCommand = pinDataCommand;
+  job.commandList = commands;
+  job.commandListSize = size;
+  spiMaster.Submit(job);
+  WaitJobDone();
+  return true;
+}
+
+// Waits until the previous job of this device is done, and resets its descriptor
+SpiMaster::Job& Spi::AcquireJob() {
+  xSemaphoreTake(jobAvailable, portMAX_DELAY);
+  job = SpiMaster::Job {};
+  job.pinCsn = pinCsn;
+  job.priority = priority;
+  job.done = jobAvailable;
+  return job;
+}
+
+void Spi::WaitJobDone() {
+  xSemaphoreTake(jobAvailable, portMAX_DELAY);
+  xSemaphoreGive(jobAvailable);
 }
 
 bool Spi::Init() {
+  if (jobAvailable == nullptr) {
+    jobAvailable = xSemaphoreCreateBinary();
+    ASSERT(jobAvailable != nullptr);
+    xSemaphoreGive(jobAvailable);
+  }
   nrf_gpio_cfg_output(pinCsn);
   nrf_gpio_pin_set(pinCsn);
   return true;
@@ -7,22 +7,36 @@ namespace Pinetime {
   namespace Drivers {
     class Spi {
     public:
-      Spi(SpiMaster& spiMaster, uint8_t pinCsn);
+      Spi(SpiMaster& spiMaster, uint8_t pinCsn, SpiMaster::Priority priority);
       Spi(const Spi&) = delete;
       Spi& operator=(const Spi&) = delete;
       Spi(Spi&&) = delete;
       Spi& operator=(Spi&&) = delete;
 
       bool Init();
+      // These functions block (without busy-waiting) until the transfer is done
       bool Write(const uint8_t* data, size_t size);
       bool Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
       bool WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
+      bool WriteCommands(uint8_t pinDataCommand, const uint8_t* commands, size_t size);
+      // Returns as soon as the transfer is queued: data must remain valid until the calling task is notified
+      // (task notification) that the transfer is done.
+      bool WriteAsync(const uint8_t* data, size_t size);
       void Sleep();
       void Wakeup();
 
     private:
+      SpiMaster::Job& AcquireJob();
+      void WaitJobDone();
+
       SpiMaster& spiMaster;
       uint8_t pinCsn;
+      SpiMaster::Priority priority;
+
+      // Descriptor of the last job submitted for this device.
+      // jobAvailable is given by SpiMaster when this job is done and the descriptor can be reused.
+      SpiMaster::Job job;
+      SemaphoreHandle_t jobAvailable = nullptr;
     };
   }
 }
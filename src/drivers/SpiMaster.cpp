@@ -6,15 +6,15 @@
 
 using namespace Pinetime::Drivers;
 
+namespace {
+  // Counts the END events of a chained transfer (see SetupChainedTransfer())
+  NRF_TIMER_Type* const chainTimer = NRF_TIMER3;
+}
+
 SpiMaster::SpiMaster(const SpiMaster::SpiModule spi, const SpiMaster::Parameters& params) : spi {spi}, params {params} {
 }
 
 bool SpiMaster::Init() {
-  if (mutex == nullptr) {
-    mutex = xSemaphoreCreateBinary();
-    ASSERT(mutex != nullptr);
-  }
-
   /* Configure GPIO pins used for pselsck, pselmosi, pselmiso and pselss for SPI0 */
   nrf_gpio_pin_set(params.pinSCK);
   nrf_gpio_cfg_output(params.pinSCK);
@@ -90,7 +90,12 @@ bool SpiMaster::Init() {
   NRFX_IRQ_PRIORITY_SET(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn, 2);
   NRFX_IRQ_ENABLE(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn);
 
-  xSemaphoreGive(mutex);
+  chainTimer->TASKS_STOP = 1;
+  chainTimer->MODE = TIMER_MODE_MODE_Counter << TIMER_MODE_MODE_Pos;
+  chainTimer->BITMODE = TIMER_BITMODE_BITMODE_16Bit << TIMER_BITMODE_BITMODE_Pos;
+  NRFX_IRQ_PRIORITY_SET(TIMER3_IRQn, 2);
+  NRFX_IRQ_ENABLE(TIMER3_IRQn);
+
   return true;
 }
 
@@ -115,39 +120,72 @@ void SpiMaster::DisableWorkaroundForFtpan58(NRF_SPIM_Type* spim, uint32_t ppi_ch
   NRF_GPIOTE->CONFIG[gpiote_channel] = 0;
   NRF_PPI->CH[ppi_channel].EEP = 0;
   NRF_PPI->CH[ppi_channel].TEP = 0;
-  NRF_PPI->CHENSET = ppi_channel;
+  NRF_PPI->CHENCLR = 1U << ppi_channel;
   spiBaseAddress->EVENTS_END = 0;
   spim->INTENSET = (1 << 6);
   spim->INTENSET = (1 << 1);
   spim->INTENSET = (1 << 19);
 }
 
-void SpiMaster::OnEndEvent() {
-  if (currentBufferAddr == 0) {
-    return;
-  }
+// Chains nbChunks transfers of maxChunkSize bytes without CPU intervention:
+//  - the ArrayList mode advances TXD.PTR by MAXCNT after each transfer;
+//  - PPI restarts the SPIM on each END event and counts the END events in chainTimer;
+//  - when the last chunk is started (COMPARE[0]), the restart channel is disabled through its PPI group;
+//  - when the last chunk is done (COMPARE[1]), chainTimer raises an interrupt (OnChainEndEvent()).
+void SpiMaster::SetupChainedTransfer(uint32_t bufferAddress, size_t nbChunks) {
+  chainTimer->TASKS_STOP = 1;
+  chainTimer->TASKS_CLEAR = 1;
+  chainTimer->CC[0] = nbChunks - 1;
+  chainTimer->CC[1] = nbChunks;
+  chainTimer->EVENTS_COMPARE[0] = 0;
+  chainTimer->EVENTS_COMPARE[1] = 0;
+  chainTimer->INTENSET = TIMER_INTENSET_COMPARE1_Msk;
+  chainTimer->TASKS_START = 1;
+
+  NRF_PPI->CH[ppiChannelChainRestart].EEP = (uint32_t) &spiBaseAddress->EVENTS_END;
+  NRF_PPI->CH[ppiChannelChainRestart].TEP = (uint32_t) &spiBaseAddress->TASKS_START;
+  NRF_PPI->CH[ppiChannelChainCount].EEP = (uint32_t) &spiBaseAddress->EVENTS_END;
+  NRF_PPI->CH[ppiChannelChainCount].TEP = (uint32_t) &chainTimer->TASKS_COUNT;
+  NRF_PPI->CH[ppiChannelChainStop].EEP = (uint32_t) &chainTimer->EVENTS_COMPARE[0];
+  NRF_PPI->CH[ppiChannelChainStop].TEP = (uint32_t) &NRF_PPI->TASKS_CHG[ppiGroupChain].DIS;
+  NRF_PPI->CHG[ppiGroupChain] = 1U << ppiChannelChainRestart;
+  NRF_PPI->CHENSET = (1U << ppiChannelChainRestart) | (1U << ppiChannelChainCount) | (1U << ppiChannelChainStop);
+
+  // The END interrupt is only needed for the remainder of the buffer, once the chain is done
+  spiBaseAddress->INTENCLR = (1 << 6);
 
-  auto s = currentBufferSize;
-  if (s > 0) {
-    auto currentSize = std::min((size_t) 255, s);
-    PrepareTx(currentBufferAddr, currentSize);
-    currentBufferAddr = currentBufferAddr + currentSize;
-    currentBufferSize = currentBufferSize - currentSize;
+  PrepareTx(bufferAddress, maxChunkSize);
+  spiBaseAddress->TXD.LIST = SPIM_TXD_LIST_LIST_ArrayList << SPIM_TXD_LIST_LIST_Pos;
+}
 
-    spiBaseAddress->TASKS_START = 1;
-  } else {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    if (taskToNotify != nullptr) {
-      vTaskNotifyGiveFromISR(taskToNotify, &xHigherPriorityTaskWoken);
-      portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-    }
+void SpiMaster::DisableChainedTransfer() {
+  chainTimer->TASKS_STOP = 1;
+  chainTimer->INTENCLR = TIMER_INTENCLR_COMPARE1_Msk;
+  chainTimer->EVENTS_COMPARE[0] = 0;
+  chainTimer->EVENTS_COMPARE[1] = 0;
 
-    nrf_gpio_pin_set(this->pinCsn);
-    currentBufferAddr = 0;
-    BaseType_t xHigherPriorityTaskWoken2 = pdFALSE;
-    xSemaphoreGiveFromISR(mutex, &xHigherPriorityTaskWoken2);
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken | xHigherPriorityTaskWoken2);
+  NRF_PPI->CHENCLR = (1U << ppiChannelChainRestart) | (1U << ppiChannelChainCount) | (1U << ppiChannelChainStop);
+  NRF_PPI->CHG[ppiGroupChain] = 0;
+
+  spiBaseAddress->TXD.LIST = 0;
+  spiBaseAddress->EVENTS_END = 0;
+  spiBaseAddress->INTENSET = (1 << 6);
+}
+
+void SpiMaster::OnChainEndEvent() {
+  DisableChainedTransfer();
+  // Send the remainder of the buffer (if any) and continue with the job
+  OnEndEvent();
+}
+
+void SpiMaster::OnEndEvent() {
+  if (currentJob == nullptr) {
+    return;
   }
+
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  Continue(&xHigherPriorityTaskWoken);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
 void SpiMaster::OnStartedEvent() {
@@ -173,77 +211,160 @@ void SpiMaster::PrepareRx(const uint32_t bufferAddress, const size_t size) {
   spiBaseAddress->EVENTS_END = 0;
 }
 
-bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size) {
-  if (data == nullptr)
-    return false;
-  auto ok = xSemaphoreTake(mutex, portMAX_DELAY);
-  ASSERT(ok == true);
-  taskToNotify = xTaskGetCurrentTaskHandle();
+void SpiMaster::Submit(Job& job) {
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-  this->pinCsn = pinCsn;
-
-  if (size == 1) {
-    SetupWorkaroundForFtpan58(spiBaseAddress, 0, 0);
+  taskENTER_CRITICAL();
+  if (currentJob == nullptr) {
+    StartJob(job);
+    Continue(&xHigherPriorityTaskWoken);
   } else {
-    DisableWorkaroundForFtpan58(spiBaseAddress, 0, 0);
+    Enqueue(job);
   }
+  taskEXIT_CRITICAL();
 
-  nrf_gpio_pin_clear(this->pinCsn);
-
-  currentBufferAddr = (uint32_t) data;
-  currentBufferSize = size;
-
-  auto currentSize = std::min((size_t) 255, (size_t) currentBufferSize);
-  PrepareTx(currentBufferAddr, currentSize);
-  currentBufferSize = currentBufferSize - currentSize;
-  currentBufferAddr = currentBufferAddr + currentSize;
-  spiBaseAddress->TASKS_START = 1;
-
-  if (size == 1) {
-    while (spiBaseAddress->EVENTS_END == 0)
-      ;
-    nrf_gpio_pin_set(this->pinCsn);
-    currentBufferAddr = 0;
-
-    DisableWorkaroundForFtpan58(spiBaseAddress, 0, 0);
-
-    xSemaphoreGive(mutex);
+  if (xHigherPriorityTaskWoken == pdTRUE) {
+    taskYIELD();
   }
-
-  return true;
 }
 
-bool SpiMaster::Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
-  xSemaphoreTake(mutex, portMAX_DELAY);
-
-  taskToNotify = nullptr;
-
-  this->pinCsn = pinCsn;
-  DisableWorkaroundForFtpan58(spiBaseAddress, 0, 0);
-  spiBaseAddress->INTENCLR = (1 << 6);
-  spiBaseAddress->INTENCLR = (1 << 1);
-  spiBaseAddress->INTENCLR = (1 << 19);
+void SpiMaster::Enqueue(Job& job) {
+  // Keep the queue sorted by priority, in order of submission for a given priority
+  Job** position = &pendingJobs;
+  while (*position != nullptr && (*position)->priority <= job.priority) {
+    position = &(*position)->next;
+  }
+  job.next = *position;
+  *position = &job;
+}
 
-  nrf_gpio_pin_clear(this->pinCsn);
+SpiMaster::Job* SpiMaster::Dequeue() {
+  Job* job = pendingJobs;
+  if (job != nullptr) {
+    pendingJobs = job->next;
+    job->next = nullptr;
+  }
+  return job;
+}
 
+void SpiMaster::StartJob(Job& job) {
+  currentJob = &job;
+  stage = Stage::CommandList;
+  commandListIndex = 0;
+  nbPendingParameters = 0;
   currentBufferAddr = 0;
   currentBufferSize = 0;
+  nrf_gpio_pin_clear(job.pinCsn);
+}
 
-  PrepareTx((uint32_t) cmd, cmdSize);
-  spiBaseAddress->TASKS_START = 1;
-  while (spiBaseAddress->EVENTS_END == 0)
-    ;
+// Starts the next transfers until one of them is running (its END event will call this function again),
+// and then starts the next job as soon as the current one is done.
+void SpiMaster::Continue(BaseType_t* higherPriorityTaskWoken) {
+  while (currentJob != nullptr && !StartNextTransfer()) {
+    FinishJob(higherPriorityTaskWoken);
+  }
+}
 
-  PrepareRx((uint32_t) data, dataSize);
-  spiBaseAddress->TASKS_START = 1;
+void SpiMaster::FinishJob(BaseType_t* higherPriorityTaskWoken) {
+  Job* job = currentJob;
+  nrf_gpio_pin_set(job->pinCsn);
 
-  while (spiBaseAddress->EVENTS_END == 0)
-    ;
-  nrf_gpio_pin_set(this->pinCsn);
+  currentJob = Dequeue();
+  if (currentJob != nullptr) {
+    StartJob(*currentJob);
+  }
 
-  xSemaphoreGive(mutex);
+  // The descriptor may be reused by its owner as soon as it is notified
+  TaskHandle_t taskToNotify = job->taskToNotify;
+  xSemaphoreGiveFromISR(job->done, higherPriorityTaskWoken);
+  if (taskToNotify != nullptr) {
+    vTaskNotifyGiveFromISR(taskToNotify, higherPriorityTaskWoken);
+  }
+}
 
-  return true;
+// Returns false when there is nothing left to transfer for the current job
+bool SpiMaster::StartNextTransfer() {
+  const Job& job = *currentJob;
+  while (true) {
+    switch (stage) {
+      case Stage::CommandList:
+        if (nbPendingParameters > 0) {
+          nrf_gpio_pin_set(job.pinDataCommand);
+          PrepareTx((uint32_t) &job.commandList[commandListIndex], nbPendingParameters);
+          commandListIndex += nbPendingParameters;
+          nbPendingParameters = 0;
+          spiBaseAddress->TASKS_START = 1;
+          return true;
+        }
+        if (commandListIndex + 1 < job.commandListSize) {
+          nbPendingParameters = job.commandList[commandListIndex + 1];
+          ASSERT(commandListIndex + 2 + nbPendingParameters <= job.commandListSize);
+          nrf_gpio_pin_clear(job.pinDataCommand);
+          PrepareTx((uint32_t) &job.commandList[commandListIndex], 1);
+          commandListIndex += 2;
+          spiBaseAddress->TASKS_START = 1;
+          return true;
+        }
+        stage = Stage::Command;
+        currentBufferAddr = (uint32_t) job.command;
+        currentBufferSize = (job.command != nullptr) ? job.commandSize : 0;
+        break;
+
+      case Stage::Command:
+        if (currentBufferSize > 0) {
+          auto currentSize = std::min(maxChunkSize, currentBufferSize);
+          PrepareTx(currentBufferAddr, currentSize);
+          currentBufferAddr = currentBufferAddr + currentSize;
+          currentBufferSize = currentBufferSize - currentSize;
+          spiBaseAddress->TASKS_START = 1;
+          return true;
+        }
+        stage = Stage::Data;
+        currentBufferAddr = (job.rxData != nullptr) ? (uint32_t) job.rxData : (uint32_t) job.txData;
+        currentBufferSize = (currentBufferAddr != 0) ? job.dataSize : 0;
+        break;
+
+      case Stage::Data: {
+        if (currentBufferSize == 0) {
+          return false;
+        }
+
+        if (job.rxData != nullptr) {
+          auto currentSize = std::min(maxChunkSize, currentBufferSize);
+          PrepareRx(currentBufferAddr, currentSize);
+          currentBufferAddr = currentBufferAddr + currentSize;
+          currentBufferSize = currentBufferSize - currentSize;
+          if (currentSize == 1) {
+            // FTPAN-58: an additional byte is clocked when RXD.MAXCNT == 1 and TXD.MAXCNT <= 1.
+            // The workaround stops the SPIM on the first SCK edge and cannot use the END interrupt.
+            SetupWorkaroundForFtpan58(spiBaseAddress, 0, 0);
+            spiBaseAddress->TASKS_START = 1;
+            while (spiBaseAddress->EVENTS_END == 0)
+              ;
+            DisableWorkaroundForFtpan58(spiBaseAddress, 0, 0);
+            break;
+          }
+          spiBaseAddress->TASKS_START = 1;
+          return true;
+        }
+
+        const size_t nbChunks = currentBufferSize / maxChunkSize;
+        if (nbChunks > 1) {
+          // Large buffers (display flushes) are sent by EasyDMA + PPI without any interrupt between the chunks.
+          SetupChainedTransfer(currentBufferAddr, nbChunks);
+          currentBufferAddr = currentBufferAddr + (nbChunks * maxChunkSize);
+          currentBufferSize = currentBufferSize - (nbChunks * maxChunkSize);
+        } else {
+          auto currentSize = std::min(maxChunkSize, currentBufferSize);
+          PrepareTx(currentBufferAddr, currentSize);
+          currentBufferAddr = currentBufferAddr + currentSize;
+          currentBufferSize = currentBufferSize - currentSize;
+        }
+        spiBaseAddress->TASKS_START = 1;
+        return true;
+      }
+    }
+  }
 }
 
 void SpiMaster::Sleep() {
@@ -261,36 +382,3 @@ void SpiMaster::Wakeup() {
   Init();
   NRF_LOG_INFO("[SPIMASTER] Wakeup");
 }
-
-bool SpiMaster::WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize) {
-  xSemaphoreTake(mutex, portMAX_DELAY);
-
-  taskToNotify = nullptr;
-
-  this->pinCsn = pinCsn;
-  DisableWorkaroundForFtpan58(spiBaseAddress, 0, 0);
-  spiBaseAddress->INTENCLR = (1 << 6);
-  spiBaseAddress->INTENCLR = (1 << 1);
-  spiBaseAddress->INTENCLR = (1 << 19);
-
-  nrf_gpio_pin_clear(this->pinCsn);
-
-  currentBufferAddr = 0;
-  currentBufferSize = 0;
-
-  PrepareTx((uint32_t) cmd, cmdSize);
-  spiBaseAddress->TASKS_START = 1;
-  while (spiBaseAddress->EVENTS_END == 0)
-    ;
-
-  PrepareTx((uint32_t) data, dataSize);
-  spiBaseAddress->TASKS_START = 1;
-
-  while (spiBaseAddress->EVENTS_END == 0)
-    ;
-  nrf_gpio_pin_set(this->pinCsn);
-
-  xSemaphoreGive(mutex);
-
-  return true;
-}
@@ -30,34 +30,88 @@ namespace Pinetime {
       SpiMaster(SpiMaster&&) = delete;
       SpiMaster& operator=(SpiMaster&&) = delete;
 
+      // Jobs are processed in order of priority, then in order of submission.
+      // A job that is already running is never preempted.
+      enum class Priority : uint8_t { High, Normal };
+
+      // Describes a transaction on the bus (CS is asserted for the whole job):
+      //  - the command list (if any) is sent first, driving the Data/Command pin.
+      //    Each command is encoded as {command, number of parameters, parameters...};
+      //  - then the command (if any);
+      //  - then the data, either sent (txData) or received (rxData).
+      // Buffers must be located in RAM (EasyDMA) and remain valid until the job is done.
+      struct Job {
+        uint8_t pinCsn = 0;
+        Priority priority = Priority::Normal;
+        uint8_t pinDataCommand = 0;
+        const uint8_t* commandList = nullptr;
+        size_t commandListSize = 0;
+        const uint8_t* command = nullptr;
+        size_t commandSize = 0;
+        const uint8_t* txData = nullptr;
+        uint8_t* rxData = nullptr;
+        size_t dataSize = 0;
+
+        // Given from the interrupt when the job is done
+        SemaphoreHandle_t done = nullptr;
+        // Optionally notified (task notification) from the interrupt when the job is done
+        TaskHandle_t taskToNotify = nullptr;
+
+        Job* next = nullptr;
+      };
+
       bool Init();
-      bool Write(uint8_t pinCsn, const uint8_t* data, size_t size);
-      bool Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
 
-      bool WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
+      // Queues the job and returns immediately. The job will be started as soon as the bus is available.
+      void Submit(Job& job);
 
       void OnStartedEvent();
       void OnEndEvent();
+      void OnChainEndEvent();
 
       void Sleep();
       void Wakeup();
 
     private:
+      enum class Stage : uint8_t { CommandList, Command, Data };
+
       void SetupWorkaroundForFtpan58(NRF_SPIM_Type* spim, uint32_t ppi_channel, uint32_t gpiote_channel);
       void DisableWorkaroundForFtpan58(NRF_SPIM_Type* spim, uint32_t ppi_channel, uint32_t gpiote_channel);
       void PrepareTx(const volatile uint32_t bufferAddress, const volatile size_t size);
       void PrepareRx(const volatile uint32_t bufferAddress, const volatile size_t size);
+      void SetupChainedTransfer(uint32_t bufferAddress, size_t nbChunks);
+      void DisableChainedTransfer();
+
+      void Enqueue(Job& job);
+      Job* Dequeue();
+      void StartJob(Job& job);
+      void Continue(BaseType_t* higherPriorityTaskWoken);
+      bool StartNextTransfer();
+      void FinishJob(BaseType_t* higherPriorityTaskWoken);
+
+      // EasyDMA MAXCNT is 8 bits wide on the nRF52832
+      static constexpr size_t maxChunkSize = 255;
+      // PPI channel 0 is used by the FTPAN-58 workaround, channels 4, 5 and 17-19 by NimBLE
+      static constexpr uint8_t ppiChannelChainRestart = 1;
+      static constexpr uint8_t ppiChannelChainCount = 2;
+      static constexpr uint8_t ppiChannelChainStop = 3;
+      static constexpr uint8_t ppiGroupChain = 0;
 
       NRF_SPIM_Type* spiBaseAddress;
-      uint8_t pinCsn;
 
       SpiMaster::SpiModule spi;
       SpiMaster::Parameters params;
 
-      volatile uint32_t currentBufferAddr = 0;
-      volatile size_t currentBufferSize = 0;
-      volatile TaskHandle_t taskToNotify;
-      SemaphoreHandle_t mutex = nullptr;
+      // Job currently owning the bus, and jobs waiting for it (sorted by priority)
+      Job* volatile currentJob = nullptr;
+      Job* pendingJobs = nullptr;
+
+      // Progress of the current job
+      Stage stage = Stage::CommandList;
+      size_t commandListIndex = 0;
+      uint8_t nbPendingParameters = 0;
+      uint32_t currentBufferAddr = 0;
+      size_t currentBufferSize = 0;
     };
   }
 }
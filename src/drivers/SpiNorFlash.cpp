@@ -10,6 +10,7 @@ SpiNorFlash::SpiNorFlash(Spi& spi) : spi {spi} {
 }
 
 void SpiNorFlash::Init() {
+  spi.Init();
   device_id = ReadIdentificaion();
   NRF_LOG_INFO("[SpiNorFlash] Manufacturer : %d, Memory type : %d, memory density : %d",
                device_id.manufacturer,
@@ -85,11 +86,39 @@ void SpiNorFlash::WriteEnable() {
 }
 
 void SpiNorFlash::SectorErase(uint32_t sectorAddress) {
+  EraseCommand(Commands::SectorErase, sectorAddress);
+}
+
+void SpiNorFlash::BlockErase32K(uint32_t blockAddress) {
+  EraseCommand(Commands::BlockErase32K, blockAddress);
+}
+
+void SpiNorFlash::BlockErase64K(uint32_t blockAddress) {
+  EraseCommand(Commands::BlockErase64K, blockAddress);
+}
+
+void SpiNorFlash::Erase(uint32_t address, size_t size) {
+  uint32_t end = address + size;
+  while (address < end) {
+    if ((address & (block64KSize - 1)) == 0 && end - address >= block64KSize) {
+      BlockErase64K(address);
+      address += block64KSize;
+    } else if ((address & (block32KSize - 1)) == 0 && end - address >= block32KSize) {
+      BlockErase32K(address);
+      address += block32KSize;
+    } else {
+      SectorErase(address);
+      address += sectorSize;
+    }
+  }
+}
+
+void SpiNorFlash::EraseCommand(Commands command, uint32_t address) {
   static constexpr uint8_t cmdSize = 4;
-  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::SectorErase),
-                          static_cast<uint8_t>(sectorAddress >> 16U),
-                          static_cast<uint8_t>(sectorAddress >> 8U),
-                          static_cast<uint8_t>(sectorAddress)};
+  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(command),
+                          static_cast<uint8_t>(address >> 16U),
+                          static_cast<uint8_t>(address >> 8U),
+                          static_cast<uint8_t>(address)};
 
   WriteEnable();
   while (!WriteEnabled())
@@ -97,8 +126,8 @@ void SpiNorFlash::SectorErase(uint32_t sectorAddress) {
 
   spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, nullptr, 0);
 
-  while (WriteInProgress())
-    vTaskDelay(1);
+  // Erasing takes tens of milliseconds, no need to poll faster than the tick
+  WaitWriteCompleted(0);
 }
 
 uint8_t SpiNorFlash::ReadSecurityRegister() {
@@ -137,11 +166,22 @@ void SpiNorFlash::Write(uint32_t address, const uint8_t* buffer, size_t size) {
 
     spi.WriteCmdAndBuffer(cmd, cmdSize, b, toWrite);
 
-    while (WriteInProgress())
-      vTaskDelay(1);
+    WaitWriteCompleted(programPollTimeUs);
 
     addr += toWrite;
     b += toWrite;
     len -= toWrite;
   }
 }
+
+void SpiNorFlash::WaitWriteCompleted(uint32_t pollTimeUs) {
+  for (uint32_t elapsed = 0; elapsed < pollTimeUs; elapsed += pollPeriodUs) {
+    if (!WriteInProgress()) {
+      return;
+    }
+    nrf_delay_us(pollPeriodUs);
+  }
+
+  while (WriteInProgress())
+    vTaskDelay(1);
+}
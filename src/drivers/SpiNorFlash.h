@@ -29,6 +29,10 @@ namespace Pinetime {
       void Write(uint32_t address, const uint8_t* buffer, size_t size);
       void WriteEnable();
       void SectorErase(uint32_t sectorAddress);
+      void BlockErase32K(uint32_t blockAddress);
+      void BlockErase64K(uint32_t blockAddress);
+      // Erases size bytes from address (both aligned on sectorSize), using the largest erase units possible
+      void Erase(uint32_t address, size_t size);
       uint8_t ReadSecurityRegister();
       bool ProgramFailed();
       bool EraseFailed();
@@ -48,11 +52,23 @@ namespace Pinetime {
         ReadConfigurationRegister = 0x15,
         SectorErase = 0x20,
         ReadSecurityRegister = 0x2B,
+        BlockErase32K = 0x52,
         ReadIdentification = 0x9F,
         ReleaseFromDeepPowerDown = 0xAB,
-        DeepPowerDown = 0xB9
+        DeepPowerDown = 0xB9,
+        BlockErase64K = 0xD8
       };
       static constexpr uint16_t pageSize = 256;
+      static constexpr uint32_t sectorSize = 0x1000;
+      static constexpr uint32_t block32KSize = 0x8000;
+      static constexpr uint32_t block64KSize = 0x10000;
+      // Programming a page typically takes less than a millisecond, so the status register is polled at a
+      // short interval for a while before falling back to tick based delays.
+      static constexpr uint32_t pollPeriodUs = 50;
+      static constexpr uint32_t programPollTimeUs = 2000;
+
+      void WaitWriteCompleted(uint32_t pollTimeUs);
+      void EraseCommand(Commands command, uint32_t address);
 
       Spi& spi;
       Identification device_id;
@@ -10,11 +10,13 @@ St7789::St7789(Spi& spi, uint8_t pinDataCommand, uint8_t pinReset) : spi {spi},
 }
 
 void St7789::Init() {
+  spi.Init();
   nrf_gpio_cfg_output(pinDataCommand);
   nrf_gpio_cfg_output(pinReset);
   nrf_gpio_pin_set(pinReset);
   HardwareReset();
   SoftwareReset();
+  addressWindowValid = false;
   SleepOut();
   ColMod();
   MemoryDataAccessControl();
@@ -30,17 +32,28 @@ void St7789::Init() {
 }
 
 void St7789::WriteCommand(uint8_t cmd) {
-  nrf_gpio_pin_clear(pinDataCommand);
-  WriteSpi(&cmd, 1);
+  WriteCommand(cmd, {});
 }
 
-void St7789::WriteData(uint8_t data) {
-  nrf_gpio_pin_set(pinDataCommand);
-  WriteSpi(&data, 1);
+void St7789::WriteCommand(uint8_t cmd, std::initializer_list<uint8_t> parameters) {
+  CommandList commands;
+  commands.Append(cmd, parameters);
+  WriteCommands(commands);
+}
+
+void St7789::WriteCommands(const CommandList& commands) {
+  spi.WriteCommands(pinDataCommand, commands.Data(), commands.Size());
+  nbTransactions++;
 }
 
 void St7789::WriteSpi(const uint8_t* data, size_t size) {
   spi.Write(data, size);
+  nbTransactions++;
+}
+
+void St7789::WriteSpiAsync(const uint8_t* data, size_t size) {
+  spi.WriteAsync(data, size);
+  nbTransactions++;
 }
 
 void St7789::SoftwareReset() {
@@ -57,13 +70,11 @@ void St7789::SleepIn() {
 }
 
 void St7789::ColMod() {
-  WriteCommand(static_cast<uint8_t>(Commands::ColMod));
-  WriteData(0x55);
+  WriteCommand(static_cast<uint8_t>(Commands::ColMod), {0x55});
   nrf_delay_ms(10);
 }
 
 void St7789::MemoryDataAccessControl() {
-  WriteCommand(static_cast<uint8_t>(Commands::MemoryDataAccessControl));
 #ifdef DRIVER_DISPLAY_MIRROR
   // [7] = MY = Page Address Order, 0 = Top to bottom, 1 = Bottom to top
   // [6] = MX = Column Address Order, 0 = Left to right, 1 = Right to left
@@ -72,26 +83,18 @@ void St7789::MemoryDataAccessControl() {
   // [3] = RGB = RGB/BGR Order, 0 = RGB, 1 = BGR
   // [2] = MH = Display Data Latch Order, 0 = LCD refresh from left to right, 1 = Right to left
   // [0 .. 1] = Unused
-  WriteData(0b01000000);
+  WriteCommand(static_cast<uint8_t>(Commands::MemoryDataAccessControl), {0b01000000});
 #else
-  WriteData(0x00);
+  WriteCommand(static_cast<uint8_t>(Commands::MemoryDataAccessControl), {0x00});
 #endif
 }
 
 void St7789::ColumnAddressSet() {
-  WriteCommand(static_cast<uint8_t>(Commands::ColumnAddressSet));
-  WriteData(0x00);
-  WriteData(0x00);
-  WriteData(Width >> 8u);
-  WriteData(Width & 0xffu);
+  WriteCommand(static_cast<uint8_t>(Commands::ColumnAddressSet), {0x00, 0x00, Width >> 8u, Width & 0xffu});
 }
 
 void St7789::RowAddressSet() {
-  WriteCommand(static_cast<uint8_t>(Commands::RowAddressSet));
-  WriteData(0x00);
-  WriteData(0x00);
-  WriteData(320u >> 8u);
-  WriteData(320u & 0xffu);
+  WriteCommand(static_cast<uint8_t>(Commands::RowAddressSet), {0x00, 0x00, Height >> 8u, Height & 0xffu});
 }
 
 void St7789::DisplayInversionOn() {
@@ -109,19 +112,25 @@ void St7789::DisplayOn() {
 }
 
 void St7789::SetAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
-  WriteCommand(static_cast<uint8_t>(Commands::ColumnAddressSet));
-  WriteData(x0 >> 8);
-  WriteData(x0 & 0xff);
-  WriteData(x1 >> 8);
-  WriteData(x1 & 0xff);
+  // Consecutive bands of the same area (and full width refreshes) share the same columns:
+  // only send the part of the window that actually changed.
+  // The window and the WriteToRam command are sent in a single transaction.
+  CommandList commands;
+  if (!addressWindowValid || columnRange.start != x0 || columnRange.end != x1) {
+    commands.Append(static_cast<uint8_t>(Commands::ColumnAddressSet),
+                    {static_cast<uint8_t>(x0 >> 8), static_cast<uint8_t>(x0 & 0xff), static_cast<uint8_t>(x1 >> 8), static_cast<uint8_t>(x1 & 0xff)});
+    columnRange = {x0, x1};
+  }
 
-  WriteCommand(static_cast<uint8_t>(Commands::RowAddressSet));
-  WriteData(y0 >> 8);
-  WriteData(y0 & 0xff);
-  WriteData(y1 >> 8);
-  WriteData(y1 & 0xff);
+  if (!addressWindowValid || rowRange.start != y0 || rowRange.end != y1) {
+    commands.Append(static_cast<uint8_t>(Commands::RowAddressSet),
+                    {static_cast<uint8_t>(y0 >> 8), static_cast<uint8_t>(y0 & 0xff), static_cast<uint8_t>(y1 >> 8), static_cast<uint8_t>(y1 & 0xff)});
+    rowRange = {y0, y1};
+  }
+  addressWindowValid = true;
 
-  WriteToRam();
+  commands.Append(static_cast<uint8_t>(Commands::WriteToRam), {});
+  WriteCommands(commands);
 }
 
 void St7789::WriteToRam() {
@@ -131,8 +140,7 @@ void St7789::WriteToRam() {
 void St7789::SetVdv() {
   // By default there is a large step from pixel brightness zero to one.
   // After experimenting with VCOMS, VRH and VDV, this was found to produce good results.
-  WriteCommand(static_cast<uint8_t>(Commands::VdvSet));
-  WriteData(0x10);
+  WriteCommand(static_cast<uint8_t>(Commands::VdvSet), {0x10});
 }
 
 void St7789::DisplayOff() {
@@ -141,20 +149,19 @@ void St7789::DisplayOff() {
 }
 
 void St7789::VerticalScrollDefinition(uint16_t topFixedLines, uint16_t scrollLines, uint16_t bottomFixedLines) {
-  WriteCommand(static_cast<uint8_t>(Commands::VerticalScrollDefinition));
-  WriteData(topFixedLines >> 8u);
-  WriteData(topFixedLines & 0x00ffu);
-  WriteData(scrollLines >> 8u);
-  WriteData(scrollLines & 0x00ffu);
-  WriteData(bottomFixedLines >> 8u);
-  WriteData(bottomFixedLines & 0x00ffu);
+  WriteCommand(static_cast<uint8_t>(Commands::VerticalScrollDefinition),
+               {static_cast<uint8_t>(topFixedLines >> 8u),
+                static_cast<uint8_t>(topFixedLines & 0x00ffu),
+                static_cast<uint8_t>(scrollLines >> 8u),
+                static_cast<uint8_t>(scrollLines & 0x00ffu),
+                static_cast<uint8_t>(bottomFixedLines >> 8u),
+                static_cast<uint8_t>(bottomFixedLines & 0x00ffu)});
 }
 
 void St7789::VerticalScrollStartAddress(uint16_t line) {
   verticalScrollingStartAddress = line;
-  WriteCommand(static_cast<uint8_t>(Commands::VerticalScrollStartAddress));
-  WriteData(line >> 8u);
-  WriteData(line & 0x00ffu);
+  WriteCommand(static_cast<uint8_t>(Commands::VerticalScrollStartAddress),
+               {static_cast<uint8_t>(line >> 8u), static_cast<uint8_t>(line & 0x00ffu)});
 }
 
 void St7789::Uninit() {
@@ -174,7 +181,7 @@ void St7789::DrawPixel(uint16_t x, uint16_t y, uint32_t color) {
 void St7789::DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size) {
   SetAddrWindow(x, y, x + width - 1, y + height - 1);
   nrf_gpio_pin_set(pinDataCommand);
-  WriteSpi(data, size);
+  WriteSpiAsync(data, size);
 }
 
 void St7789::HardwareReset() {
@@ -191,6 +198,7 @@ void St7789::Sleep() {
 
 void St7789::Wakeup() {
   nrf_gpio_cfg_output(pinDataCommand);
+  addressWindowValid = false;
   SleepOut();
   VerticalScrollStartAddress(verticalScrollingStartAddress);
   DisplayOn();
@@ -1,6 +1,7 @@
 #pragma once
 #include <cstddef>
 #include <cstdint>
+#include <initializer_list>
 
 namespace Pinetime {
   namespace Drivers {
@@ -21,16 +22,56 @@ namespace Pinetime {
       void VerticalScrollDefinition(uint16_t topFixedLines, uint16_t scrollLines, uint16_t bottomFixedLines);
       void VerticalScrollStartAddress(uint16_t line);
 
+      // Returns as soon as the transfer is queued. The calling task is notified when data can be reused.
       void DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size);
 
       void Sleep();
       void Wakeup();
 
+      // Number of SPI transactions (command lists and pixel data) sent to the display since boot
+      uint32_t NbTransactions() const {
+        return nbTransactions;
+      }
+
     private:
+      // Commands and their parameters, encoded for SpiMaster::WriteCommands()
+      class CommandList {
+      public:
+        void Append(uint8_t command, std::initializer_list<uint8_t> parameters) {
+          buffer[size++] = command;
+          buffer[size++] = static_cast<uint8_t>(parameters.size());
+          for (auto parameter : parameters) {
+            buffer[size++] = parameter;
+          }
+        }
+
+        const uint8_t* Data() const {
+          return buffer;
+        }
+
+        size_t Size() const {
+          return size;
+        }
+
+      private:
+        uint8_t buffer[24];
+        size_t size = 0;
+      };
+
       Spi& spi;
       uint8_t pinDataCommand;
       uint8_t pinReset;
       uint8_t verticalScrollingStartAddress = 0;
+      uint32_t nbTransactions = 0;
+
+      // Last address window sent to the controller, used to skip redundant CASET/RASET commands
+      struct AddressRange {
+        uint16_t start;
+        uint16_t end;
+      };
+      AddressRange columnRange {};
+      AddressRange rowRange {};
+      bool addressWindowValid = false;
 
       void HardwareReset();
       void SoftwareReset();
@@ -47,7 +88,10 @@ namespace Pinetime {
       void SetAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
       void SetVdv();
       void WriteCommand(uint8_t cmd);
+      void WriteCommand(uint8_t cmd, std::initializer_list<uint8_t> parameters);
+      void WriteCommands(const CommandList& commands);
       void WriteSpi(const uint8_t* data, size_t size);
+      void WriteSpiAsync(const uint8_t* data, size_t size);
 
       enum class Commands : uint8_t {
         SoftwareReset = 0x01,
@@ -66,7 +110,6 @@ namespace Pinetime {
         ColMod = 0x3a,
         VdvSet = 0xc4,
       };
-      void WriteData(uint8_t data);
       void ColumnAddressSet();
 
       static constexpr uint16_t Width = 240;
@@ -5,9 +5,6 @@
 
 using namespace Pinetime::Drivers;
 
-// TODO use shortcut to automatically send STOP when receive LastTX, for example
-// TODO use DMA/IRQ
-
 TwiMaster::TwiMaster(NRF_TWIM_Type* module, uint32_t frequency, uint8_t pinSda, uint8_t pinScl)
   : module {module}, frequency {frequency}, pinSda {pinSda}, pinScl {pinScl} {
 }
@@ -26,6 +23,9 @@ void TwiMaster::Init() {
   if (mutex == nullptr) {
     mutex = xSemaphoreCreateBinary();
   }
+  if (transfersDone == nullptr) {
+    transfersDone = xSemaphoreCreateBinary();
+  }
 
   ConfigurePins();
 
@@ -43,16 +43,31 @@ void TwiMaster::Init() {
   twiBaseAddress->EVENTS_SUSPENDED = 0;
   twiBaseAddress->EVENTS_TXSTARTED = 0;
 
+  twiBaseAddress->INTENSET = TWIM_INTENSET_STOPPED_Msk | TWIM_INTENSET_ERROR_Msk;
+  NRFX_IRQ_PRIORITY_SET(nrfx_get_irq_number(twiBaseAddress), 2);
+  NRFX_IRQ_ENABLE(nrfx_get_irq_number(twiBaseAddress));
+
   twiBaseAddress->ENABLE = (TWIM_ENABLE_ENABLE_Enabled << TWIM_ENABLE_ENABLE_Pos);
 
   xSemaphoreGive(mutex);
 }
 
 TwiMaster::ErrorCodes TwiMaster::Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t* data, size_t size) {
+  const ReadTransfer transfer {deviceAddress, registerAddress, data, size};
+  return Read(&transfer, 1);
+}
+
+TwiMaster::ErrorCodes TwiMaster::Read(const ReadTransfer* transfers, size_t nbTransfers) {
+  if (nbTransfers == 0) {
+    return ErrorCodes::NoError;
+  }
   xSemaphoreTake(mutex, portMAX_DELAY);
   Wakeup();
-  auto ret = Write(deviceAddress, &registerAddress, 1, false);
-  ret = Read(deviceAddress, data, size, true);
+  transferFailed = false;
+  pendingTransfers = transfers + 1;
+  nbPendingTransfers = nbTransfers - 1;
+  StartRead(transfers[0]);
+  auto ret = WaitTransfersDone(nbTransfers);
   Sleep();
   xSemaphoreGive(mutex);
   return ret;
@@ -64,95 +79,73 @@ TwiMaster::ErrorCodes TwiMaster::Write(uint8_t deviceAddress, uint8_t registerAd
   Wakeup();
   internalBuffer[0] = registerAddress;
   std::memcpy(internalBuffer + 1, data, size);
-  auto ret = Write(deviceAddress, internalBuffer, size + 1, true);
+  transferFailed = false;
+  nbPendingTransfers = 0;
+  StartWrite(deviceAddress, internalBuffer, size + 1);
+  auto ret = WaitTransfersDone(1);
   Sleep();
   xSemaphoreGive(mutex);
   return ret;
 }
 
-TwiMaster::ErrorCodes TwiMaster::Read(uint8_t deviceAddress, uint8_t* buffer, size_t size, bool stop) {
-  twiBaseAddress->ADDRESS = deviceAddress;
-  twiBaseAddress->TASKS_RESUME = 0x1UL;
-  twiBaseAddress->RXD.PTR = (uint32_t) buffer;
-  twiBaseAddress->RXD.MAXCNT = size;
-
-  twiBaseAddress->TASKS_STARTRX = 1;
-
-  while (!twiBaseAddress->EVENTS_RXSTARTED && !twiBaseAddress->EVENTS_ERROR)
-    ;
-  twiBaseAddress->EVENTS_RXSTARTED = 0x0UL;
-
-  txStartedCycleCount = DWT->CYCCNT;
-  uint32_t currentCycleCount;
-  while (!twiBaseAddress->EVENTS_LASTRX && !twiBaseAddress->EVENTS_ERROR) {
-    currentCycleCount = DWT->CYCCNT;
-    if ((currentCycleCount - txStartedCycleCount) > HwFreezedDelay) {
-      FixHwFreezed();
-      return ErrorCodes::TransactionFailed;
-    }
-  }
-  twiBaseAddress->EVENTS_LASTRX = 0x0UL;
-
-  if (stop || twiBaseAddress->EVENTS_ERROR) {
-    twiBaseAddress->TASKS_STOP = 0x1UL;
-    while (!twiBaseAddress->EVENTS_STOPPED)
-      ;
-    twiBaseAddress->EVENTS_STOPPED = 0x0UL;
-  } else {
-    twiBaseAddress->TASKS_SUSPEND = 0x1UL;
-    while (!twiBaseAddress->EVENTS_SUSPENDED)
-      ;
-    twiBaseAddress->EVENTS_SUSPENDED = 0x0UL;
-  }
-
-  if (twiBaseAddress->EVENTS_ERROR) {
-    twiBaseAddress->EVENTS_ERROR = 0x0UL;
-  }
-  return ErrorCodes::NoError;
+// Writes the register address, then reads the data and sends STOP without CPU intervention (shortcuts).
+void TwiMaster::StartRead(const ReadTransfer& transfer) {
+  twiBaseAddress->ADDRESS = transfer.deviceAddress;
+  twiBaseAddress->TXD.PTR = (uint32_t) &transfer.registerAddress;
+  twiBaseAddress->TXD.MAXCNT = registerSize;
+  twiBaseAddress->RXD.PTR = (uint32_t) transfer.data;
+  twiBaseAddress->RXD.MAXCNT = transfer.size;
+  twiBaseAddress->SHORTS = TWIM_SHORTS_LASTTX_STARTRX_Msk | TWIM_SHORTS_LASTRX_STOP_Msk;
+  twiBaseAddress->TASKS_STARTTX = 1;
 }
 
-TwiMaster::ErrorCodes TwiMaster::Write(uint8_t deviceAddress, const uint8_t* data, size_t size, bool stop) {
+void TwiMaster::StartWrite(uint8_t deviceAddress, const uint8_t* data, size_t size) {
   twiBaseAddress->ADDRESS = deviceAddress;
-  twiBaseAddress->TASKS_RESUME = 0x1UL;
   twiBaseAddress->TXD.PTR = (uint32_t) data;
   twiBaseAddress->TXD.MAXCNT = size;
-
+  twiBaseAddress->SHORTS = TWIM_SHORTS_LASTTX_STOP_Msk;
   twiBaseAddress->TASKS_STARTTX = 1;
+}
 
-  while (!twiBaseAddress->EVENTS_TXSTARTED && !twiBaseAddress->EVENTS_ERROR)
-    ;
-  twiBaseAddress->EVENTS_TXSTARTED = 0x0UL;
-
-  txStartedCycleCount = DWT->CYCCNT;
-  uint32_t currentCycleCount;
-  while (!twiBaseAddress->EVENTS_LASTTX && !twiBaseAddress->EVENTS_ERROR) {
-    currentCycleCount = DWT->CYCCNT;
-    if ((currentCycleCount - txStartedCycleCount) > HwFreezedDelay) {
-      FixHwFreezed();
-      return ErrorCodes::TransactionFailed;
-    }
-  }
-  twiBaseAddress->EVENTS_LASTTX = 0x0UL;
-
-  if (stop || twiBaseAddress->EVENTS_ERROR) {
-    twiBaseAddress->TASKS_STOP = 0x1UL;
-    while (!twiBaseAddress->EVENTS_STOPPED)
-      ;
-    twiBaseAddress->EVENTS_STOPPED = 0x0UL;
-  } else {
-    twiBaseAddress->TASKS_SUSPEND = 0x1UL;
-    while (!twiBaseAddress->EVENTS_SUSPENDED)
-      ;
-    twiBaseAddress->EVENTS_SUSPENDED = 0x0UL;
+TwiMaster::ErrorCodes TwiMaster::WaitTransfersDone(size_t nbTransfers) {
+  if (xSemaphoreTake(transfersDone, transferTimeout * nbTransfers) != pdTRUE) {
+    nbPendingTransfers = 0;
+    FixHwFreezed();
+    // Discard the end of the batch if it was signaled in the meantime
+    xSemaphoreTake(transfersDone, 0);
+    return ErrorCodes::TransactionFailed;
   }
+  return transferFailed ? ErrorCodes::TransactionFailed : ErrorCodes::NoError;
+}
 
+void TwiMaster::OnInterrupt() {
   if (twiBaseAddress->EVENTS_ERROR) {
     twiBaseAddress->EVENTS_ERROR = 0x0UL;
     uint32_t error = twiBaseAddress->ERRORSRC;
     twiBaseAddress->ERRORSRC = error;
+    transferFailed = true;
+    // The shortcuts do not apply when the device does not acknowledge
+    twiBaseAddress->TASKS_STOP = 0x1UL;
   }
 
-  return ErrorCodes::NoError;
+  if (twiBaseAddress->EVENTS_STOPPED) {
+    twiBaseAddress->EVENTS_STOPPED = 0x0UL;
+    twiBaseAddress->EVENTS_LASTTX = 0x0UL;
+    twiBaseAddress->EVENTS_LASTRX = 0x0UL;
+
+    if (!transferFailed && nbPendingTransfers > 0) {
+      const ReadTransfer* transfer = pendingTransfers;
+      pendingTransfers = transfer + 1;
+      nbPendingTransfers = nbPendingTransfers - 1;
+      StartRead(*transfer);
+      return;
+    }
+
+    nbPendingTransfers = 0;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(transfersDone, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+  }
 }
 
 void TwiMaster::Sleep() {
@@ -171,7 +164,7 @@ void TwiMaster::Wakeup() {
 void TwiMaster::FixHwFreezed() {
   NRF_LOG_INFO("I2C device frozen, reinitializing it!");
 
-  uint32_t twi_state = NRF_TWI1->ENABLE;
+  uint32_t twi_state = twiBaseAddress->ENABLE;
 
   Sleep();
 
@@ -10,23 +10,39 @@ namespace Pinetime {
     public:
       enum class ErrorCodes { NoError, TransactionFailed };
 
+      // Reads size bytes from the device at deviceAddress, starting at registerAddress.
+      // The transfer must be located in RAM (EasyDMA).
+      struct ReadTransfer {
+        uint8_t deviceAddress;
+        uint8_t registerAddress;
+        uint8_t* data;
+        size_t size;
+      };
+
       TwiMaster(NRF_TWIM_Type* module, uint32_t frequency, uint8_t pinSda, uint8_t pinScl);
 
       void Init();
       ErrorCodes Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t* buffer, size_t size);
+      // Executes all the transfers in a single batch: the bus is acquired once and the transfers are chained
+      // from the interrupt handler. The calling task sleeps until the last one is done.
+      ErrorCodes Read(const ReadTransfer* transfers, size_t nbTransfers);
       ErrorCodes Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t* data, size_t size);
 
+      void OnInterrupt();
+
       void Sleep();
       void Wakeup();
 
     private:
-      ErrorCodes Read(uint8_t deviceAddress, uint8_t* buffer, size_t size, bool stop);
-      ErrorCodes Write(uint8_t deviceAddress, const uint8_t* data, size_t size, bool stop);
+      void StartRead(const ReadTransfer& transfer);
+      void StartWrite(uint8_t deviceAddress, const uint8_t* data, size_t size);
+      ErrorCodes WaitTransfersDone(size_t nbTransfers);
       void FixHwFreezed();
       void ConfigurePins() const;
 
       NRF_TWIM_Type* twiBaseAddress;
       SemaphoreHandle_t mutex = nullptr;
+      SemaphoreHandle_t transfersDone = nullptr;
       NRF_TWIM_Type* module;
       uint32_t frequency;
       uint8_t pinSda;
@@ -34,8 +50,13 @@ namespace Pinetime {
       static constexpr uint8_t maxDataSize {16};
       static constexpr uint8_t registerSize {1};
       uint8_t internalBuffer[maxDataSize + registerSize];
-      uint32_t txStartedCycleCount = 0;
-      static constexpr uint32_t HwFreezedDelay {161000};
+
+      // Transfers of the current batch that are not started yet
+      const ReadTransfer* volatile pendingTransfers = nullptr;
+      volatile size_t nbPendingTransfers = 0;
+      volatile bool transferFailed = false;
+      // A transfer takes less than 1ms at 400Khz
+      static constexpr TickType_t transferTimeout {pdMS_TO_TICKS(10)};
     };
   }
 }
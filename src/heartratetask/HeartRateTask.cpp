@@ -5,6 +5,14 @@
 
 using namespace Pinetime::Applications;
 
+namespace {
+  // Wrap-around safe number of ticks until deadline, 0 if it is reached
+  TickType_t TicksUntil(TickType_t deadline) {
+    auto remaining = static_cast<int32_t>(deadline - xTaskGetTickCount());
+    return remaining > 0 ? static_cast<TickType_t>(remaining) : 0;
+  }
+}
+
 HeartRateTask::HeartRateTask(Drivers::Hrs3300& heartRateSensor, Controllers::HeartRateController& controller)
   : heartRateSensor {heartRateSensor}, controller {controller} {
 }
@@ -24,25 +32,19 @@ void HeartRateTask::Process(void* instance) {
 }
 
 void HeartRateTask::Work() {
-  int lastBpm = 0;
   while (true) {
     Messages msg;
-    uint32_t delay;
-    if (state == States::Running) {
-      if (measurementStarted) {
-        delay = ppg.deltaTms;
-      } else {
-        delay = 100;
-      }
-    } else {
-      delay = portMAX_DELAY;
-    }
-
-    if (xQueueReceive(messageQueue, &msg, delay)) {
+    if (xQueueReceive(messageQueue, &msg, CurrentDelay())) {
       switch (msg) {
         case Messages::GoToSleep:
           StopMeasurement();
-          state = States::Idle;
+          if (measurementStarted) {
+            // Keep tracking the heart rate with short measurements while the system sleeps
+            state = States::Background;
+            backgroundDeadline = xTaskGetTickCount() + backgroundPeriod;
+          } else {
+            state = States::Idle;
+          }
           break;
         case Messages::WakeUp:
           state = States::Running;
@@ -69,35 +71,119 @@ void HeartRateTask::Work() {
       }
     }
 
-    if (measurementStarted) {
-      int8_t ambient = ppg.Preprocess(heartRateSensor.ReadHrs(), heartRateSensor.ReadAls());
-      int bpm = ppg.HeartRate();
-
-      // If ambient light detected or a reset requested (bpm < 0)
-      if (ambient > 0) {
-        // Reset all DAQ buffers
-        ppg.Reset(true);
-        // Force state to NotEnoughData (below)
-        lastBpm = 0;
-        bpm = 0;
-      } else if (bpm < 0) {
-        // Reset all DAQ buffers except HRS buffer
-        ppg.Reset(false);
-        // Set HR to zero and update
-        bpm = 0;
-        controller.Update(Controllers::HeartRateController::States::Running, bpm);
-      }
+    if (state == States::Background && measurementStarted) {
+      BackgroundWork();
+    } else if (sensorEnabled) {
+      HandleSensorData();
+    }
+  }
+}
 
-      if (lastBpm == 0 && bpm == 0) {
-        controller.Update(Controllers::HeartRateController::States::NotEnoughData, bpm);
+TickType_t HeartRateTask::CurrentDelay() const {
+  switch (state) {
+    case States::Running:
+      return measurementStarted ? ppg.deltaTms : 100;
+    case States::Background:
+      if (!measurementStarted) {
+        return portMAX_DELAY;
       }
-
-      if (bpm != 0) {
-        lastBpm = bpm;
-        controller.Update(Controllers::HeartRateController::States::Running, lastBpm);
+      if (sensorEnabled) {
+        return ppg.deltaTms;
       }
+      return TicksUntil(backgroundDeadline);
+    default:
+      return portMAX_DELAY;
+  }
+}
+
+void HeartRateTask::BackgroundWork() {
+  if (!sensorEnabled) {
+    if (TicksUntil(backgroundDeadline) == 0) {
+      lastBpm = 0;
+      backgroundValidUpdates = 0;
+      StartMeasurement();
+      backgroundDeadline += backgroundWindow;
+    }
+    return;
+  }
+
+  int bpm = HandleSensorData();
+  if (bpm > 0) {
+    backgroundValidUpdates++;
+  } else {
+    backgroundValidUpdates = 0;
+  }
+  // Stop once the heart rate is stable or at the end of the window, the next one starts backgroundPeriod after this one
+  if (backgroundValidUpdates >= backgroundMinValidUpdates || TicksUntil(backgroundDeadline) == 0) {
+    StopMeasurement();
+    backgroundDeadline += backgroundPeriod - backgroundWindow;
+  }
+}
+
+int HeartRateTask::HandleSensorData() {
+  auto values = heartRateSensor.ReadHrsAls();
+  if (AdjustSensor(values.hrs)) {
+    // The signal level changed, the samples acquired so far can't be used anymore
+    ppg.Reset(true);
+    return 0;
+  }
+
+  int8_t ambient = ppg.Preprocess(values.hrs, values.als);
+  int bpm = ppg.HeartRate();
+
+  // If ambient light detected or a reset requested (bpm < 0)
+  if (ambient > 0) {
+    // Reset all DAQ buffers
+    ppg.Reset(true);
+    // Force state to NotEnoughData (below)
+    lastBpm = 0;
+    bpm = 0;
+  } else if (bpm < 0) {
+    // Reset all DAQ buffers except HRS buffer
+    ppg.Reset(false);
+    // Set HR to zero and update
+    bpm = 0;
+    controller.Update(Controllers::HeartRateController::States::Running, bpm);
+  }
+
+  if (lastBpm == 0 && bpm == 0) {
+    controller.Update(Controllers::HeartRateController::States::NotEnoughData, bpm);
+  }
+
+  if (bpm != 0) {
+    lastBpm = bpm;
+    controller.Update(Controllers::HeartRateController::States::Running, lastBpm);
+  }
+  return bpm;
+}
+
+// Steps the sensitivity of the sensor up or down when the HRS value stays out of range.
+// Returns true if the sensitivity changed.
+bool HeartRateTask::AdjustSensor(uint32_t hrs) {
+  if (hrs > hrsHighThreshold && sensorLevel > 0) {
+    samplesOutOfRange++;
+    if (samplesOutOfRange >= sensorAdjustmentDelay) {
+      sensorLevel--;
+      ApplySensorLevel();
+      return true;
+    }
+  } else if (hrs < hrsLowThreshold && sensorLevel < nbSensorLevels - 1) {
+    samplesOutOfRange++;
+    if (samplesOutOfRange >= sensorAdjustmentDelay) {
+      sensorLevel++;
+      ApplySensorLevel();
+      return true;
     }
+  } else {
+    samplesOutOfRange = 0;
   }
+  return false;
+}
+
+void HeartRateTask::ApplySensorLevel() {
+  samplesOutOfRange = 0;
+  heartRateSensor.SetDrive(sensorLevels[sensorLevel].drive);
+  heartRateSensor.SetGain(sensorLevels[sensorLevel].gain);
 }
 
 void HeartRateTask::PushMessage(HeartRateTask::Messages msg) {
@@ -111,12 +197,16 @@ void HeartRateTask::PushMessage(HeartRateTask::Messages msg) {
 
 void HeartRateTask::StartMeasurement() {
   heartRateSensor.Enable();
+  // Enable() resets the LED drive current, the level found during the previous measurement is a good starting point
+  ApplySensorLevel();
+  sensorEnabled = true;
   ppg.Reset(true);
   vTaskDelay(100);
 }
 
 void HeartRateTask::StopMeasurement() {
   heartRateSensor.Disable();
+  sensorEnabled = false;
   ppg.Reset(true);
   vTaskDelay(100);
 }
@@ -3,12 +3,9 @@
 #include <task.h>
 #include <queue.h>
 #include <components/heartrate/Ppg.h>
+#include <drivers/Hrs3300.h>
 
 namespace Pinetime {
-  namespace Drivers {
-    class Hrs3300;
-  }
-
   namespace Controllers {
     class HeartRateController;
   }
@@ -17,7 +14,8 @@ namespace Pinetime {
     class HeartRateTask {
     public:
       enum class Messages : uint8_t { GoToSleep, WakeUp, StartMeasurement, StopMeasurement };
-      enum class States { Idle, Running };
+      // Background: the system is sleeping, the measurement runs for backgroundWindow every backgroundPeriod
+      enum class States { Idle, Running, Background };
 
       explicit HeartRateTask(Drivers::Hrs3300& heartRateSensor, Controllers::HeartRateController& controller);
       void Start();
@@ -28,6 +26,30 @@ namespace Pinetime {
       static void Process(void* instance);
       void StartMeasurement();
       void StopMeasurement();
+      int HandleSensorData();
+      bool AdjustSensor(uint32_t hrs);
+      void ApplySensorLevel();
+      TickType_t CurrentDelay() const;
+      void BackgroundWork();
+
+      // Sensitivity levels of the sensor (LED drive current, then gain), from the lowest to the highest
+      struct SensorLevel {
+        uint8_t drive;
+        uint8_t gain;
+      };
+      static constexpr SensorLevel sensorLevels[] = {{0, 1}, {1, 1}, {2, 1}, {3, 1}, {3, 2}, {3, 4}, {3, 8}};
+      static constexpr uint8_t nbSensorLevels = sizeof(sensorLevels) / sizeof(sensorLevels[0]);
+      // Target range of the HRS value: high enough for a usable signal, and below the full scale of the conversions,
+      // where the signal saturates
+      static constexpr uint32_t hrsLowThreshold = 0x0800;
+      static constexpr uint32_t hrsHighThreshold = Drivers::Hrs3300::maxHrsValue / 8 * 7;
+      // Number of consecutive samples out of range before the sensitivity is changed
+      static constexpr uint8_t sensorAdjustmentDelay = 5;
+
+      static constexpr TickType_t backgroundPeriod = pdMS_TO_TICKS(5 * 60 * 1000);
+      static constexpr TickType_t backgroundWindow = pdMS_TO_TICKS(30 * 1000);
+      // A background measurement stops early after this number of consecutive valid heart rate updates
+      static constexpr uint8_t backgroundMinValidUpdates = 4;
 
       TaskHandle_t taskHandle;
       QueueHandle_t messageQueue;
@@ -36,6 +58,13 @@ namespace Pinetime {
       Controllers::HeartRateController& controller;
       Controllers::Ppg ppg;
       bool measurementStarted = false;
+      bool sensorEnabled = false;
+      int lastBpm = 0;
+      uint8_t sensorLevel = 0;
+      uint8_t samplesOutOfRange = 0;
+      uint8_t backgroundValidUpdates = 0;
+      // Start of the next background measurement, or end of the current one when the sensor is enabled
+      TickType_t backgroundDeadline = 0;
     };
 
   }
@@ -42,10 +42,10 @@ Pinetime::Drivers::SpiMaster spi {Pinetime::Drivers::SpiMaster::SpiModule::SPI0,
                                    Pinetime::PinMap::SpiSck,
                                    Pinetime::PinMap::SpiMosi,
                                    Pinetime::PinMap::SpiMiso}};
-Pinetime::Drivers::Spi flashSpi {spi, Pinetime::PinMap::SpiFlashCsn};
+Pinetime::Drivers::Spi flashSpi {spi, Pinetime::PinMap::SpiFlashCsn, Pinetime::Drivers::SpiMaster::Priority::High};
 Pinetime::Drivers::SpiNorFlash spiNorFlash {flashSpi};
 
-Pinetime::Drivers::Spi lcdSpi {spi, Pinetime::PinMap::SpiLcdCsn};
+Pinetime::Drivers::Spi lcdSpi {spi, Pinetime::PinMap::SpiLcdCsn, Pinetime::Drivers::SpiMaster::Priority::Normal};
 Pinetime::Drivers::St7789 lcd {lcdSpi, Pinetime::PinMap::LcdDataCommand, Pinetime::PinMap::LcdReset};
 
 Pinetime::Components::Gfx gfx {lcd};
@@ -74,6 +74,13 @@ void SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQHandler(void) {
     NRF_SPIM0->EVENTS_STOPPED = 0;
   }
 }
+
+void TIMER3_IRQHandler(void) {
+  if (NRF_TIMER3->EVENTS_COMPARE[1] == 1) {
+    NRF_TIMER3->EVENTS_COMPARE[1] = 0;
+    spi.OnChainEndEvent();
+  }
+}
 }
 
 void RefreshWatchdog() {
@@ -98,8 +105,10 @@ void Process(void* /*instance*/) {
   DisplayLogo();
 
   NRF_LOG_INFO("Erasing...");
-  for (uint32_t erased = 0; erased < sizeof(recoveryImage); erased += 0x1000) {
-    spiNorFlash.SectorErase(erased);
+  // Erased by 64KB blocks (the end with 32KB blocks and sectors), refreshing the watchdog between them
+  static constexpr uint32_t eraseSize = (sizeof(recoveryImage) + 0xfff) & ~0xfffu;
+  for (uint32_t erased = 0; erased < eraseSize; erased += 0x10000) {
+    spiNorFlash.Erase(erased, std::min<uint32_t>(0x10000, eraseSize - erased));
     RefreshWatchdog();
   }
 
@@ -11,6 +11,7 @@ namespace Pinetime {
       OnNewNotification,
       OnNewCall,
       BleConnected,
+      BleDiscoveryTimerExpired,
       BleFirmwareUpdateStarted,
       BleFirmwareUpdateFinished,
       OnTouchEvent,
@@ -23,9 +24,12 @@ namespace Pinetime {
       OnNewHour,
       OnNewHalfHour,
       OnChargingEvent,
+      OnMotionFifoWatermark,
       OnPairing,
       SetOffAlarm,
       MeasureBatteryTimerExpired,
+      TimeEventTimerExpired,
+      TimeEventChanged,
       BatteryPercentageUpdated,
       StartFileTransfer,
       StopFileTransfer,
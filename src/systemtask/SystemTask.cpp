@@ -32,6 +32,11 @@ void MeasureBatteryTimerCallback(TimerHandle_t xTimer) {
   sysTask->PushMessage(Pinetime::System::Messages::MeasureBatteryTimerExpired);
 }
 
+void BleDiscoveryTimerCallback(TimerHandle_t xTimer) {
+  auto* sysTask = static_cast<SystemTask*>(pvTimerGetTimerID(xTimer));
+  sysTask->PushMessage(Pinetime::System::Messages::BleDiscoveryTimerExpired);
+}
+
 SystemTask::SystemTask(Drivers::SpiMaster& spi,
                        Pinetime::Drivers::SpiNorFlash& spiNorFlash,
                        Drivers::TwiMaster& twiMaster,
@@ -51,7 +56,8 @@ SystemTask::SystemTask(Drivers::SpiMaster& spi,
                        Pinetime::Applications::HeartRateTask& heartRateApp,
                        Pinetime::Controllers::FS& fs,
                        Pinetime::Controllers::TouchHandler& touchHandler,
-                       Pinetime::Controllers::ButtonHandler& buttonHandler)
+                       Pinetime::Controllers::ButtonHandler& buttonHandler,
+                       Pinetime::Controllers::FrameStatistics& frameStatistics)
   : spi {spi},
     spiNorFlash {spiNorFlash},
     twiMaster {twiMaster},
@@ -80,7 +86,8 @@ SystemTask::SystemTask(Drivers::SpiMaster& spi,
                      spiNorFlash,
                      heartRateController,
                      motionController,
-                     fs) {
+                     fs,
+                     frameStatistics) {
 }
 
 void SystemTask::Start() {
@@ -173,18 +180,31 @@ void SystemTask::Work() {
   nrfx_gpiote_in_init(PinMap::PowerPresent, &pinConfig, nrfx_gpiote_evt_handler);
   nrfx_gpiote_in_event_enable(PinMap::PowerPresent, true);
 
+  // Motion sensor FIFO watermark
+  pinConfig.sense = NRF_GPIOTE_POLARITY_LOTOHI;
+  pinConfig.pull = NRF_GPIO_PIN_NOPULL;
+  nrfx_gpiote_in_init(PinMap::Bma421Irq, &pinConfig, nrfx_gpiote_evt_handler);
+  nrfx_gpiote_in_event_enable(PinMap::Bma421Irq, true);
+
   batteryController.MeasureVoltage();
 
   measureBatteryTimer = xTimerCreate("measureBattery", batteryMeasurementPeriod, pdTRUE, this, MeasureBatteryTimerCallback);
   xTimerStart(measureBatteryTimer, portMAX_DELAY);
+  bleDiscoveryTimer = xTimerCreate("bleDiscovery", bleDiscoveryDelay, pdFALSE, this, BleDiscoveryTimerCallback);
+
+  wakeUpsWindowStart = xTaskGetTickCount();
 
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "EndlessLoop"
   while (true) {
-    UpdateMotion();
+    // The task is woken up by the messages pushed by the event sources (GPIOTE interrupts for the button, the touch
+    // panel and the motion sensor FIFO watermark, BLE, timers). The timeout only keeps the time and the motion up to
+    // date while the display is on, and reloads the watchdog while sleeping.
+    const TickType_t timeout = (state == SystemTaskState::Sleeping) ? sleepingUpdatePeriod : runningUpdatePeriod;
 
     Messages msg;
-    if (xQueueReceive(systemTasksMsgQueue, &msg, 100) == pdTRUE) {
+    if (xQueueReceive(systemTasksMsgQueue, &msg, timeout) == pdTRUE) {
+      messageWakeUps++;
       switch (msg) {
         case Messages::EnableSleeping:
           // Make sure that exiting an app doesn't enable sleeping,
@@ -215,6 +235,8 @@ void SystemTask::Work() {
           }
 
           state = SystemTaskState::Running;
+          // The FIFO was not read while sleeping: drain it so that the watermark interrupt is signaled again
+          UpdateMotion();
           break;
         case Messages::TouchWakeUp: {
           if (touchHandler.ProcessTouchInfo(touchPanel.GetTouchInfo())) {
@@ -257,6 +279,11 @@ void SystemTask::Work() {
           }
           break;
         case Messages::SetOffAlarm:
+          if (alarmController.State() != Controllers::AlarmController::AlarmState::Set) {
+            // The alarm was disabled in the meantime
+            break;
+          }
+          alarmController.SetOffAlarmNow();
           if (state == SystemTaskState::Sleeping) {
             GoToRunning();
           }
@@ -264,8 +291,12 @@ void SystemTask::Work() {
           break;
         case Messages::BleConnected:
           displayApp.PushMessage(Pinetime::Applications::Display::Messages::RestoreBrightness);
-          isBleDiscoveryTimerRunning = true;
-          bleDiscoveryTimer = 5;
+          xTimerStart(bleDiscoveryTimer, 0);
+          break;
+        case Messages::BleDiscoveryTimerExpired:
+          // Services discovery is deferred from 3 seconds to avoid the conflicts between the host communicating with the
+          // target and vice-versa. I'm not sure if this is the right way to handle this...
+          nimbleController.StartDiscovery();
           break;
         case Messages::BleFirmwareUpdateStarted:
           doNotGoToSleep = true;
@@ -331,6 +362,12 @@ void SystemTask::Work() {
           }
 
           state = SystemTaskState::Sleeping;
+          // The FIFO is not read while going to sleep: drain it, otherwise the interrupt line stays high and no
+          // watermark interrupt is generated anymore.
+          UpdateMotion();
+          break;
+        case Messages::OnMotionFifoWatermark:
+          UpdateMotion();
           break;
         case Messages::OnNewDay:
           // We might be sleeping (with TWI device disabled.
@@ -369,6 +406,10 @@ void SystemTask::Work() {
         case Messages::MeasureBatteryTimerExpired:
           batteryController.MeasureVoltage();
           break;
+        case Messages::TimeEventTimerExpired:
+        case Messages::TimeEventChanged:
+          // The time events are notified by dateTimeController.UpdateTime() below
+          break;
         case Messages::BatteryPercentageUpdated:
           nimbleController.NotifyBatteryLevel(batteryController.PercentRemaining());
           break;
@@ -388,17 +429,22 @@ void SystemTask::Work() {
         default:
           break;
       }
+    } else {
+      idleWakeUps++;
+      // In case a watermark interrupt was missed
+      if (state == SystemTaskState::Running || nrf_gpio_pin_read(PinMap::Bma421Irq) != 0) {
+        UpdateMotion();
+      }
     }
 
-    if (isBleDiscoveryTimerRunning) {
-      if (bleDiscoveryTimer == 0) {
-        isBleDiscoveryTimerRunning = false;
-        // Services discovery is deferred from 3 seconds to avoid the conflicts between the host communicating with the
-        // target and vice-versa. I'm not sure if this is the right way to handle this...
-        nimbleController.StartDiscovery();
-      } else {
-        bleDiscoveryTimer--;
-      }
+    const TickType_t now = xTaskGetTickCount();
+    if (now - wakeUpsWindowStart >= pdMS_TO_TICKS(60 * 1000)) {
+      idleWakeUpsPerMinute = idleWakeUps;
+      messageWakeUpsPerMinute = messageWakeUps;
+      idleWakeUps = 0;
+      messageWakeUps = 0;
+      wakeUpsWindowStart = now;
+      NRF_LOG_INFO("[systemtask] Wake-ups : %d idle, %d messages /min", idleWakeUpsPerMinute, messageWakeUpsPerMinute);
     }
 
     monitor.Process();
@@ -427,9 +473,19 @@ void SystemTask::UpdateMotion() {
     stepCounterMustBeReset = false;
   }
 
-  auto motionValues = motionSensor.Process();
-
-  motionController.Update(motionValues.x, motionValues.y, motionValues.z, motionValues.steps);
+  // The FIFO is read again while it is above the watermark, as no rising edge will be generated until it is read.
+  // The number of reads is bounded so that a failing sensor or a stuck interrupt line cannot keep the task busy,
+  // the remaining data is read at the next wake-up.
+  for (uint8_t i = 0; i < maxMotionReads; i++) {
+    auto motionValues = motionSensor.Process();
+    if (!motionValues.isOk) {
+      break;
+    }
+    motionController.Update(motionValues.samples, motionValues.nbSamples, motionValues.steps);
+    if (nrf_gpio_pin_read(PinMap::Bma421Irq) == 0) {
+      break;
+    }
+  }
 
   if (settingsController.GetNotificationStatus() != Controllers::Settings::Notification::Sleep) {
     if ((settingsController.isWakeUpModeOn(Pinetime::Controllers::Settings::WakeUpMode::RaiseWrist) &&
@@ -507,6 +563,11 @@ void SystemTask::PushMessage(System::Messages msg) {
       /* Actual macro used here is port specific. */
       portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
     }
+  } else if (xTaskGetCurrentTaskHandle() == taskHandle) {
+    // The task would wait for itself to empty the queue
+    if (xQueueSend(systemTasksMsgQueue, &msg, 0) != pdTRUE) {
+      NRF_LOG_INFO("[systemtask] Queue full, message %d dropped", static_cast<uint8_t>(msg));
+    }
   } else {
     xQueueSend(systemTasksMsgQueue, &msg, portMAX_DELAY);
   }
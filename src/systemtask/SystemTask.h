@@ -47,6 +47,7 @@ namespace Pinetime {
     class Battery;
     class TouchHandler;
     class ButtonHandler;
+    class FrameStatistics;
   }
 
   namespace System {
@@ -72,7 +73,8 @@ namespace Pinetime {
                  Pinetime::Applications::HeartRateTask& heartRateApp,
                  Pinetime::Controllers::FS& fs,
                  Pinetime::Controllers::TouchHandler& touchHandler,
-                 Pinetime::Controllers::ButtonHandler& buttonHandler);
+                 Pinetime::Controllers::ButtonHandler& buttonHandler,
+                 Pinetime::Controllers::FrameStatistics& frameStatistics);
 
       void Start();
       void PushMessage(Messages msg);
@@ -94,6 +96,16 @@ namespace Pinetime {
         return state == SystemTaskState::Sleeping || state == SystemTaskState::WakingUp;
       }
 
+      // Number of times the task woke up without any message to process during the last minute
+      uint16_t IdleWakeUpsPerMinute() const {
+        return idleWakeUpsPerMinute;
+      }
+
+      // Number of messages processed by the task during the last minute
+      uint16_t MessageWakeUpsPerMinute() const {
+        return messageWakeUpsPerMinute;
+      }
+
     private:
       TaskHandle_t taskHandle;
 
@@ -124,8 +136,7 @@ namespace Pinetime {
 
       static void Process(void* instance);
       void Work();
-      bool isBleDiscoveryTimerRunning = false;
-      uint8_t bleDiscoveryTimer = 0;
+      TimerHandle_t bleDiscoveryTimer;
       TimerHandle_t measureBatteryTimer;
       bool doNotGoToSleep = false;
       SystemTaskState state = SystemTaskState::Running;
@@ -137,6 +148,19 @@ namespace Pinetime {
       void UpdateMotion();
       bool stepCounterMustBeReset = false;
       static constexpr TickType_t batteryMeasurementPeriod = pdMS_TO_TICKS(10 * 60 * 1000);
+      static constexpr TickType_t bleDiscoveryDelay = pdMS_TO_TICKS(3000);
+      // Period of the time update while the display is on
+      static constexpr TickType_t runningUpdatePeriod = pdMS_TO_TICKS(100);
+      // Longest time without waking up while sleeping, it must be shorter than the watchdog timeout (7s)
+      static constexpr TickType_t sleepingUpdatePeriod = pdMS_TO_TICKS(5000);
+      // Maximum number of FIFO reads in a single call to UpdateMotion()
+      static constexpr uint8_t maxMotionReads = 3;
+
+      TickType_t wakeUpsWindowStart = 0;
+      uint16_t idleWakeUps = 0;
+      uint16_t idleWakeUpsPerMinute = 0;
+      uint16_t messageWakeUps = 0;
+      uint16_t messageWakeUpsPerMinute = 0;
 
       SystemMonitor monitor;
     };